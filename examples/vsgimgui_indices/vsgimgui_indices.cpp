@@ -0,0 +1,209 @@
+#include <vsg/all.h>
+
+#include <vsgImGui/RenderImGui.h>
+#include <vsgImGui/SendEventsToImGui.h>
+#include <vsgImGui/imgui.h>
+#include <vsgImGui/implot.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+// Measures the draw calls and CPU cost of uploading and recording a dense ImPlot line plot, for a range of point counts, with the ImDrawIdx size
+// vsgImGui was built with. Build once with the default 16-bit indices and once with -DVSGIMGUI_32BIT_INDICES=ON and compare the output of the two runs.
+
+class PlotGui : public vsg::Inherit<vsg::Command, PlotGui>
+{
+public:
+    explicit PlotGui(size_t numPoints)
+    {
+        setNumPoints(numPoints);
+    }
+
+    std::vector<float> xs;
+    std::vector<float> ys;
+
+    void setNumPoints(size_t numPoints)
+    {
+        xs.resize(numPoints);
+        ys.resize(numPoints);
+        for (size_t i = 0; i < numPoints; ++i)
+        {
+            xs[i] = static_cast<float>(i) / static_cast<float>(numPoints);
+            ys[i] = 0.5f + 0.5f * std::sin(xs[i] * 200.0f) * std::cos(xs[i] * 7.0f);
+        }
+    }
+
+    void record(vsg::CommandBuffer&) const override
+    {
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin("vsgimgui_indices", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove);
+        if (ImPlot::BeginPlot("dense", ImVec2(-1.0f, -1.0f)))
+        {
+            ImPlot::PlotLine("signal", xs.data(), ys.data(), static_cast<int>(xs.size()));
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+    }
+};
+
+// time the building of the UI separately from the upload and recording of its draw data
+class TimedRenderImGui : public vsg::Inherit<vsgImGui::RenderImGui, TimedRenderImGui>
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    TimedRenderImGui(const vsg::ref_ptr<vsg::Window>& window) :
+        Inherit(window) {}
+
+    mutable uint32_t numFrames = 0;
+    mutable double buildTime = 0.0;  // milliseconds
+    mutable double recordTime = 0.0; // milliseconds
+    mutable uint64_t uploadedBytes = 0;
+    mutable int numVertices = 0;
+    mutable int numIndices = 0;
+    mutable uint32_t numSegments = 0; // runs of draw commands sharing a VtxOffset, more than one per draw list when 16-bit indices overflow
+
+    void reset()
+    {
+        numFrames = 0;
+        buildTime = 0.0;
+        recordTime = 0.0;
+        uploadedBytes = 0;
+    }
+
+    void accept(vsg::RecordTraversal& rt) const override
+    {
+        auto start = clock::now();
+        if (!build(rt)) return;
+        auto built = clock::now();
+        record(rt, false);
+        auto recorded = clock::now();
+
+        ContextScope scope(this);
+        auto drawData = ImGui::GetDrawData();
+
+        ++numFrames;
+        buildTime += std::chrono::duration<double, std::milli>(built - start).count();
+        recordTime += std::chrono::duration<double, std::milli>(recorded - built).count();
+        uploadedBytes += static_cast<uint64_t>(drawData->TotalVtxCount) * sizeof(ImDrawVert) + static_cast<uint64_t>(drawData->TotalIdxCount) * sizeof(ImDrawIdx);
+
+        numVertices = drawData->TotalVtxCount;
+        numIndices = drawData->TotalIdxCount;
+        numSegments = 0;
+        for (int n = 0; n < drawData->CmdListsCount; ++n)
+        {
+            const ImDrawList* cmd_list = drawData->CmdLists[n];
+            for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; ++cmd_i)
+            {
+                if (cmd_i == 0 || cmd_list->CmdBuffer[cmd_i].VtxOffset != cmd_list->CmdBuffer[cmd_i - 1].VtxOffset) ++numSegments;
+            }
+        }
+    }
+
+protected:
+    ~TimedRenderImGui() {}
+};
+
+int main(int argc, char** argv)
+{
+    vsg::CommandLine arguments(&argc, argv);
+
+    auto windowTraits = vsg::WindowTraits::create(arguments);
+    windowTraits->windowTitle = "vsgimgui_indices";
+    windowTraits->swapchainPreferences.presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+
+    auto minPoints = std::max(arguments.value<size_t>(1000, "--min-points"), size_t(1));
+    auto maxPoints = arguments.value<size_t>(1000000, "--max-points");
+    auto numFrames = arguments.value<uint32_t>(200, "--frames");
+
+    // GPU timestamps are reset on the host, which requires the hostQueryReset feature, so they are opt in
+    bool gpuTiming = arguments.read("--gpu");
+    if (gpuTiming)
+    {
+        windowTraits->vulkanVersion = VK_API_VERSION_1_2;
+        if (!windowTraits->deviceFeatures) windowTraits->deviceFeatures = vsg::DeviceFeatures::create();
+        windowTraits->deviceFeatures->get<VkPhysicalDeviceHostQueryResetFeatures, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES>().hostQueryReset = VK_TRUE;
+    }
+
+    if (arguments.errors()) return arguments.writeErrorMessages(std::cerr);
+
+    auto viewer = vsg::Viewer::create();
+    auto window = vsg::Window::create(windowTraits);
+    if (!window)
+    {
+        std::cout << "Could not create window." << std::endl;
+        return 1;
+    }
+    viewer->addWindow(window);
+
+    auto plotGui = PlotGui::create(minPoints);
+    auto renderImGui = TimedRenderImGui::create(window);
+    renderImGui->addChild(plotGui);
+    if (gpuTiming) renderImGui->setupTimestamps(numFrames);
+
+    auto renderGraph = vsg::RenderGraph::create(window);
+    renderGraph->addChild(renderImGui);
+
+    auto commandGraph = vsg::CommandGraph::create(window);
+    commandGraph->addChild(renderGraph);
+
+    viewer->addEventHandler(vsgImGui::SendEventsToImGui::create());
+    viewer->addEventHandler(vsg::CloseHandler::create(viewer));
+    viewer->assignRecordAndSubmitTaskAndPresentation({commandGraph});
+    viewer->compile();
+
+    auto renderer = renderImGui->getRenderer();
+
+    // run numFrames frames, returning false if the viewer was closed before any were recorded
+    auto runFrames = [&](bool retain) {
+        renderer->retainUnchangedFrames = retain;
+        renderImGui->reset();
+        for (uint32_t i = 0; i < numFrames && viewer->advanceToNextFrame(); ++i)
+        {
+            viewer->handleEvents();
+            viewer->update();
+            viewer->recordAndSubmit();
+            viewer->present();
+        }
+        return renderImGui->numFrames > 0;
+    };
+
+    std::cout << "ImDrawIdx : " << sizeof(ImDrawIdx) * 8 << "-bit, " << numFrames << " frames per row" << std::endl;
+    std::cout << std::setw(10) << "points" << std::setw(10) << "vertices" << std::setw(10) << "indices" << std::setw(8) << "draws" << std::setw(10) << "segments"
+              << std::setw(12) << "build ms" << std::setw(20) << "upload+record ms" << std::setw(20) << "retained record ms";
+    if (gpuTiming) std::cout << std::setw(10) << "GPU ms";
+    std::cout << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (size_t numPoints = minPoints; numPoints <= maxPoints; numPoints *= 10)
+    {
+        plotGui->setNumPoints(numPoints);
+
+        // first upload the draw data every frame, then retain it as the plot doesn't change, so only the draw commands are recorded
+        // and the difference between the two is the cost of the upload
+        auto startStats = renderer->getRecordStats();
+        if (!runFrames(false)) break;
+
+        auto stats = renderer->getRecordStats();
+        double frames = static_cast<double>(renderImGui->numFrames);
+        double drawCalls = static_cast<double>(stats.totalDrawCalls - startStats.totalDrawCalls) / frames;
+        double buildTime = renderImGui->buildTime / frames;
+        double uploadTime = renderImGui->recordTime / frames;
+        auto timings = renderImGui->getTimingStats(); // the timing window spans numFrames, so covers the frames just uploaded
+
+        if (!runFrames(true)) break;
+        double recordTime = renderImGui->recordTime / static_cast<double>(renderImGui->numFrames);
+
+        std::cout << std::setw(10) << numPoints << std::setw(10) << renderImGui->numVertices << std::setw(10) << renderImGui->numIndices
+                  << std::setw(8) << std::setprecision(0) << drawCalls << std::setprecision(3) << std::setw(10) << renderImGui->numSegments
+                  << std::setw(12) << buildTime << std::setw(20) << uploadTime << std::setw(20) << recordTime;
+        if (gpuTiming) std::cout << std::setw(10) << timings.gpuTime.average;
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
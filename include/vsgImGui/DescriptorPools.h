@@ -0,0 +1,80 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/vk/DescriptorPool.h>
+
+#include <vsgImGui/Export.h>
+
+#include <map>
+#include <mutex>
+
+namespace vsgImGui
+{
+
+    /// DescriptorPools allocates the COMBINED_IMAGE_SAMPLER descriptor sets used as ImTextureID, starting with a small
+    /// vsg::DescriptorPool and chaining further pools, each double the size of the last, as more sets are required.
+    class VSGIMGUI_DECLSPEC DescriptorPools : public vsg::Inherit<vsg::Object, DescriptorPools>
+    {
+    public:
+        explicit DescriptorPools(vsg::ref_ptr<vsg::Device> in_device, uint32_t in_initialMaxSets = 4);
+
+        const vsg::ref_ptr<vsg::Device> device;
+
+        /// number of sets in the first pool, subsequent pools double in size.
+        const uint32_t initialMaxSets;
+
+        /// allocate a descriptor set with a layout that has a single COMBINED_IMAGE_SAMPLER binding.
+        VkDescriptorSet allocate(VkDescriptorSetLayout descriptorSetLayout);
+
+        /// return a descriptor set to the pool it was allocated from.
+        void free(VkDescriptorSet descriptorSet);
+
+        struct Stats
+        {
+            uint32_t numPools = 0;
+            uint32_t numAllocatedSets = 0;
+            uint32_t numFreeSets = 0;
+        };
+
+        Stats getStats() const;
+
+    protected:
+        virtual ~DescriptorPools();
+
+        struct Pool
+        {
+            vsg::ref_ptr<vsg::DescriptorPool> descriptorPool;
+            uint32_t maxSets = 0;
+            uint32_t numAllocatedSets = 0;
+        };
+
+        mutable std::mutex _mutex;
+        std::vector<Pool> _pools;
+        std::map<VkDescriptorSet, size_t> _allocations;
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::DescriptorPools);
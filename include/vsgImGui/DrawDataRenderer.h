@@ -0,0 +1,268 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/state/BufferInfo.h>
+#include <vsg/state/GraphicsPipeline.h>
+#include <vsg/state/ImageInfo.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/DeviceFeatures.h>
+#include <vsg/vk/MemoryBufferPools.h>
+#include <vsg/vk/State.h>
+
+#include <map>
+#include <mutex>
+
+#include <vsgImGui/Export.h>
+#include <vsgImGui/PipelineCache.h>
+#include <vsgImGui/imgui.h>
+
+namespace vsgImGui
+{
+
+    /// DrawDataRenderer records ImDrawData into a vsg::CommandBuffer using a vsg::GraphicsPipeline that is bound via vsg::State,
+    /// with the vertex and index buffers sub-allocated from vsg::MemoryBufferPools.
+    class VSGIMGUI_DECLSPEC DrawDataRenderer : public vsg::Inherit<vsg::Object, DrawDataRenderer>
+    {
+    public:
+        /// set up the pipeline for context.renderPass and the vertex/index buffers for numFrames frames in flight.
+        DrawDataRenderer(vsg::Context& context, uint32_t numFrames);
+
+        vsg::ref_ptr<vsg::Device> device;
+        vsg::ref_ptr<vsg::DescriptorSetLayout> descriptorSetLayout;
+        vsg::ref_ptr<vsg::PipelineLayout> pipelineLayout;
+        vsg::ref_ptr<BindCachedGraphicsPipeline> bindGraphicsPipeline;
+        vsg::ref_ptr<vsg::MemoryBufferPools> memoryBufferPools;
+
+        /// optional mapping applied to the ImTextureIDs of the draw commands, used when recording a UI built with another device's descriptor sets.
+        std::map<ImTextureID, ImTextureID> textureMap;
+
+        /// enable the bindless texture path, where the textures registered with addBindlessTexture(..) are sampled from a single array of maxTextures descriptors
+        /// indexed via a push constant, so only one descriptor set is bound per frame. Call before compile(..), requires the shaderSampledImageArrayDynamicIndexing feature
+        /// and maxTextures to be within the device's maxPerStageDescriptorSamplers/SampledImages limits. Unregistered textures are bound individually as before.
+        void setupBindlessTextures(uint32_t maxTextures);
+        uint32_t getMaxBindlessTextures() const { return _bindless.maxTextures; }
+
+        /// register the compiled image that the ImTextureID's descriptor set refers to, returns false if the descriptor array is full or the image isn't compiled.
+        bool addBindlessTexture(ImTextureID id, vsg::ref_ptr<vsg::ImageInfo> imageInfo);
+        bool hasBindlessTexture(ImTextureID id) const { return _bindless.indices.count(id) != 0; }
+
+        vsg::ref_ptr<vsg::DescriptorSetLayout> bindlessDescriptorSetLayout;
+        vsg::ref_ptr<vsg::PipelineLayout> bindlessPipelineLayout;
+        vsg::ref_ptr<BindCachedGraphicsPipeline> bindBindlessGraphicsPipeline;
+
+        /// index type matching ImDrawIdx, 32-bit when vsgImGui is built with VSGIMGUI_32BIT_INDICES.
+        static constexpr VkIndexType indexType = (sizeof(ImDrawIdx) == 2) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+
+        /// compile the pipeline, using bindGraphicsPipeline->pipelineCache when assigned.
+        void compile(vsg::Context& context);
+        bool compiled(uint32_t deviceID) const { return bindGraphicsPipeline->vk(deviceID) != VK_NULL_HANDLE; }
+
+        /// factor applied to the required size when a vertex/index buffer has to grow, reducing reallocations as the UI grows.
+        double growthFactor = 1.5;
+
+        /// a buffer is shrunk once its usage has been below shrinkThreshold * capacity for shrinkDelay consecutive uses.
+        double shrinkThreshold = 0.25;
+        uint32_t shrinkDelay = 600;
+
+        /// buffers are never shrunk below these sizes, in bytes.
+        VkDeviceSize minimumVertexBufferSize = 64 * sizeof(ImDrawVert);
+        VkDeviceSize minimumIndexBufferSize = 64 * sizeof(ImDrawIdx);
+
+        struct BufferStats
+        {
+            uint32_t numFrames = 0;              // number of per frame in flight slots
+            VkDeviceSize vertexBufferSize = 0;   // largest vertex buffer capacity across slots, in bytes
+            VkDeviceSize indexBufferSize = 0;    // largest index buffer capacity across slots, in bytes
+            VkDeviceSize peakVertexDataSize = 0; // largest vertex data uploaded in a single frame, in bytes
+            VkDeviceSize peakIndexDataSize = 0;  // largest index data uploaded in a single frame, in bytes
+            uint32_t numGrows = 0;
+            uint32_t numShrinks = 0;
+        };
+
+        /// statistics on the vertex/index buffer sizes and resizes, use peakVertexDataSize/peakIndexDataSize to choose sizes to reserve(..) up front
+        BufferStats getBufferStats() const { return _bufferStats; }
+
+        /// reserve capacity in each frame's vertex and index buffers, sizes in bytes.
+        void reserve(VkDeviceSize vertexBufferSize, VkDeviceSize indexBufferSize);
+
+        /// when enabled the ImDrawData is fingerprinted each frame and, if unchanged from the previous frame,
+        /// the previously uploaded vertex/index buffers are reused so only the draw commands are recorded.
+        /// The fingerprint hashes the vertex/index data, which is cheaper than writing it to the buffers but not free, so an IdlePolicy remains the cheaper way to retain whole frames.
+        bool retainUnchangedFrames = false;
+
+        /// when enabled consecutive ImDrawCmds with the same texture, scissor and base vertex whose indices follow on are drawn with a single vkCmdDrawIndexed.
+        /// Compare RecordStats::numDrawCommands with numDrawCalls to see the effect. Redundant scissor and descriptor set binds are always skipped.
+        bool mergeDrawCommands = false;
+
+        /// copy the buffer sizing, retainUnchangedFrames and mergeDrawCommands settings from another renderer, such as the primary device's.
+        void copySettings(const DrawDataRenderer& rhs);
+
+        struct RecordStats
+        {
+            uint64_t numUploadedFrames = 0;     // frames where the vertex/index data was uploaded
+            uint64_t numRetainedFrames = 0;     // frames where the previously uploaded vertex/index data was reused
+            uint32_t numDrawCommands = 0;       // visible ImDrawCmds in the most recent record(..), prior to merging
+            uint64_t totalDrawCommands = 0;     // visible ImDrawCmds in all record(..) calls, prior to merging
+            uint32_t numDrawCalls = 0;          // vkCmdDrawIndexed calls made by the most recent record(..)
+            uint64_t totalDrawCalls = 0;        // vkCmdDrawIndexed calls made by all record(..) calls
+            uint32_t numDescriptorSetBinds = 0; // vkCmdBindDescriptorSets calls made by the most recent record(..)
+        };
+
+        /// return a copy of the stats, safe to call from threads other than the record thread, such as a RenderImGui build thread.
+        RecordStats getRecordStats() const
+        {
+            std::scoped_lock<std::mutex> lock(_recordStatsMutex);
+            return _recordStats;
+        }
+
+        /// write GPU timestamps before and after the UI's draw commands. The results are read back, without waiting, when a query slot comes round again
+        /// and accumulated over the last windowSize frames. The UI is recorded inside a render pass, where queries can't be reset by command, so they are
+        /// reset on the host: timing is only enabled when deviceFeatures, the features the device was created with, enable hostQueryReset via
+        /// VkPhysicalDeviceHostQueryResetFeatures or VkPhysicalDeviceVulkan12Features, and the queue family supports timestamps.
+        void setupTimestamps(uint32_t windowSize, const vsg::DeviceFeatures* deviceFeatures);
+
+        struct Range
+        {
+            double min = 0.0;
+            double average = 0.0;
+            double max = 0.0;
+        };
+
+        struct TimingStats
+        {
+            uint32_t numFrames = 0; // frames with GPU timings in the window
+            Range gpuTime;          // milliseconds between the timestamps
+            Range drawCalls;
+            Range vertices;
+            Range indices;
+            Range descriptorSetBinds; // texture binds
+        };
+
+        /// rolling min/average/max over the frames timed by setupTimestamps(..), safe to call from threads other than the record thread.
+        TimingStats getTimingStats() const;
+
+        /// compute a hash of drawData's draw commands and vertex/index data, equal fingerprints mean the ImDrawData renders the same.
+        static uint64_t fingerprint(const ImDrawData* drawData);
+
+        /// record the draw commands for drawData into the State's command buffer.
+        /// unchanged signals that drawData is the same as the previous call, so the uploaded vertex/index data can be reused.
+        /// frameCount, the FrameStamp's frameCount, lets GPU timing reuse timestamp queries left unwritten by command buffers that were never submitted.
+        void record(vsg::State& state, const ImDrawData* drawData, bool unchanged = false, uint64_t frameCount = 0);
+
+    protected:
+        virtual ~DrawDataRenderer();
+
+        /// persistently mapped buffer sub-allocated from memoryBufferPools
+        struct MappedBuffer
+        {
+            vsg::ref_ptr<vsg::BufferInfo> bufferInfo;
+            void* data = nullptr;
+            VkDeviceSize capacity = 0;
+            uint32_t lowUsageCount = 0;
+        };
+
+        struct FrameBuffers
+        {
+            MappedBuffer vertices;
+            MappedBuffer indices;
+            VkDescriptorSet bindlessDescriptorSet = VK_NULL_HANDLE;
+            uint64_t bindlessVersion = 0;
+        };
+
+        // each frame in flight has its own copy of the bindless descriptor array, updated when it's next used after textures are registered
+        struct BindlessTextures
+        {
+            uint32_t maxTextures = 0;
+            VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+            std::map<ImTextureID, uint32_t> indices;
+            std::vector<vsg::ref_ptr<vsg::ImageInfo>> images;
+            uint64_t version = 0;
+        };
+        BindlessTextures _bindless;
+
+        struct FrameSample
+        {
+            double gpuTime = 0.0;
+            uint32_t drawCalls = 0;
+            uint32_t vertices = 0;
+            uint32_t indices = 0;
+            uint32_t descriptorSetBinds = 0;
+        };
+
+        // each slot has a pair of queries, written when the slot was last used and read back once they are available
+        struct TimestampSlot
+        {
+            bool pending = false;
+            uint64_t frameCount = 0; // frame the queries were recorded for
+            FrameSample sample;
+        };
+
+        struct Timestamps
+        {
+            VkQueryPool queryPool = VK_NULL_HANDLE;
+            PFN_vkResetQueryPool vkResetQueryPool = nullptr;
+            double timestampPeriod = 1.0; // nanoseconds per tick
+            uint64_t timestampMask = ~0ull; // timestampValidBits of the queue family
+            std::vector<TimestampSlot> slots;
+            size_t slotIndex = 0;
+            std::vector<FrameSample> window;
+            size_t windowIndex = 0;
+            size_t numSamples = 0;
+        };
+        Timestamps _timestamps;
+        mutable std::mutex _timestampsMutex;
+
+        std::vector<FrameBuffers> _frames;
+        size_t _frameIndex = 0;
+        uint32_t _queueFamily = 0;
+        BufferStats _bufferStats;
+        mutable std::mutex _recordStatsMutex;
+        RecordStats _recordStats;
+
+        FrameBuffers* _retainedFrame = nullptr;
+        uint64_t _retainedFingerprint = 0;
+
+        // the pool's DeviceMemory blocks can be shared by several buffers so map each block once and reference count its use.
+        struct MappedMemory
+        {
+            vsg::ref_ptr<vsg::DeviceMemory> memory;
+            void* data = nullptr;
+            uint32_t referenceCount = 0;
+        };
+        std::map<vsg::DeviceMemory*, MappedMemory> _mappedMemory;
+
+        bool _allocate(MappedBuffer& mappedBuffer, VkDeviceSize size, VkBufferUsageFlags usage);
+        void _release(MappedBuffer& mappedBuffer);
+        bool _resize(MappedBuffer& mappedBuffer, VkDeviceSize requiredSize, VkDeviceSize minimumSize, VkBufferUsageFlags usage);
+        void _updateBufferStats();
+        void _upload(FrameBuffers& frame, const ImDrawData* drawData);
+        void _updateBindlessDescriptorSet(FrameBuffers& frame);
+        TimestampSlot* _writeStartTimestamp(vsg::CommandBuffer& commandBuffer, uint64_t frameCount);
+        void _setupRenderState(vsg::CommandBuffer& commandBuffer, const FrameBuffers& frame, int fb_width, int fb_height);
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::DrawDataRenderer);
@@ -0,0 +1,51 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Inherit.h>
+#include <vsg/core/Object.h>
+
+#include <vsgImGui/Export.h>
+#include <vsgImGui/imgui.h>
+
+namespace vsgImGui
+{
+
+    /// DrawDataSnapshot is an immutable deep copy of an ImDrawData and its draw lists, allowing the UI built on one thread to be recorded on another
+    /// while ImGui goes on to build the next frame.
+    class VSGIMGUI_DECLSPEC DrawDataSnapshot : public vsg::Inherit<vsg::Object, DrawDataSnapshot>
+    {
+    public:
+        explicit DrawDataSnapshot(const ImDrawData* in_drawData);
+
+        /// copy of the source ImDrawData, its CmdLists are owned by the snapshot. OwnerViewport is not copied.
+        ImDrawData drawData;
+
+    protected:
+        virtual ~DrawDataSnapshot();
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::DrawDataSnapshot);
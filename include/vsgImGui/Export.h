@@ -41,6 +41,25 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vulkan/vulkan.h>
 #define ImTextureID VkDescriptorSet
 
+// enabled by the VSGIMGUI_32BIT_INDICES CMake option, so large meshes such as dense ImPlot plots don't have to be split into 64k vertex segments
+#if defined(VSGIMGUI_32BIT_INDICES)
+#    define ImDrawIdx unsigned int
+#endif
+
+// the current ImGui and ImPlot contexts are per thread, so the UIs of different windows can be built and recorded in parallel.
+// They are accessed through functions as thread_local variables can't be exported from a DLL.
+struct ImGuiContext;
+struct ImPlotContext;
+
+namespace vsgImGui
+{
+    extern VSGIMGUI_DECLSPEC ImGuiContext*& currentImGuiContext();
+    extern VSGIMGUI_DECLSPEC ImPlotContext*& currentImPlotContext();
+} // namespace vsgImGui
+
+#define GImGui (vsgImGui::currentImGuiContext())
+#define GImPlot (vsgImGui::currentImPlotContext())
+
 #include <vsg/maths/vec2.h>
 #include <vsg/maths/vec4.h>
 
@@ -0,0 +1,138 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array2D.h>
+#include <vsg/io/Options.h>
+#include <vsg/nodes/Compilable.h>
+#include <vsg/state/DescriptorImage.h>
+#include <vsg/state/DescriptorSetLayout.h>
+
+#include <vsgImGui/DescriptorPools.h>
+#include <vsgImGui/imgui.h>
+
+#include <memory>
+#include <mutex>
+
+namespace vsgImGui
+{
+
+    /// FontAtlas uploads the pixels of an ImFontAtlas to the GPU and assigns the resulting descriptor set as the atlas's ImTextureID.
+    /// As a vsg::Compilable it is compiled along with the rest of the scene graph by the viewer's CompileTraversal, so the transfer
+    /// is batched with other startup work rather than blocking on a dedicated queue submission.
+    class VSGIMGUI_DECLSPEC FontAtlas : public vsg::Inherit<vsg::Compilable, FontAtlas>
+    {
+    public:
+        FontAtlas(ImFontAtlas* in_atlas, vsg::ref_ptr<DescriptorPools> in_descriptorPools, vsg::ref_ptr<vsg::DescriptorSetLayout> in_descriptorSetLayout);
+
+        ImFontAtlas* atlas = nullptr;
+        vsg::ref_ptr<DescriptorPools> descriptorPools;
+        vsg::ref_ptr<vsg::DescriptorSetLayout> descriptorSetLayout;
+        vsg::ref_ptr<vsg::Sampler> sampler;
+
+        /// when true the atlas is deleted along with the FontAtlas, so it remains valid while any of the ImGuiContexts sharing it exist.
+        bool ownsAtlas = false;
+
+        /// assign the descriptor set as the atlas's ImTextureID when compiled, disabled for the copies of the atlas used on additional devices.
+        bool assignTexID = true;
+
+        /// image created from the atlas pixels on first compile
+        vsg::ref_ptr<vsg::DescriptorImage> image;
+
+        /// when set, the baked atlas pixels and glyph tables are read from/written to a vsgb file in this directory,
+        /// named using a hash of the font data, sizes, glyph ranges and oversampling, so later runs avoid rasterizing the fonts.
+        vsg::Path cacheDirectory;
+        vsg::ref_ptr<const vsg::Options> options;
+
+        /// compute the hash of the atlas's font configuration used to key the cache file.
+        uint64_t configurationHash() const;
+
+        /// build the atlas, reading it from the cache if possible and writing it to the cache once built. Called by compile(..).
+        void build();
+
+        /// build the atlas if required, set up the image and descriptor set and queue the transfer of the pixels on the context.
+        /// The texture is resident once the context's transfer commands have been submitted and completed.
+        void compile(vsg::Context& context) override;
+
+        /// return true if compile(..) has been called for the specified device.
+        bool compiled(uint32_t deviceID) const { return _descriptorSet != VK_NULL_HANDLE && deviceID == _deviceID; }
+
+        ImTextureID id() const { return _descriptorSet; }
+
+        /// when enabled, a dynamicRegionSize area of the atlas is reserved when it's built and glyphs outside of the fonts' baked
+        /// GlyphRanges are rasterized into it once requested with requestGlyphs(..), so large character sets such as CJK only need to bake
+        /// a small base range and no per codepoint work or memory is spent on glyphs that are never used. Glyphs aren't detected on first use,
+        /// as ImGui looks glyphs up without any hook for misses, which would otherwise need a placeholder for every codepoint of the fonts,
+        /// so request the text a frame will draw before drawing it. Text drawn with glyphs that haven't been requested uses the font's fallback glyph.
+        /// Must be set before the atlas is built.
+        bool dynamicGlyphs = false;
+        VkExtent2D dynamicRegionSize = {1024, 1024};
+
+        /// request the glyphs required to render the UTF-8 text, for the specified font or all fonts when nullptr.
+        /// Pending glyphs are rasterized by the next update(..), glyphs requested while building a frame are available from the following frame.
+        void requestGlyphs(const char* text, const char* text_end = nullptr, const ImFont* font = nullptr);
+        void requestGlyph(ImWchar c, const ImFont* font = nullptr);
+
+        /// rasterize the pending glyphs into the dynamic region and submit the copy of just the dirty sub rectangles without waiting for it.
+        /// While the copy is in flight the glyphs have placeholders that draw nothing but advance the text correctly.
+        /// Later calls poll the copy and, once it has completed, replace the placeholders with the new glyphs and return true.
+        /// Called by RenderImGui prior to ImGui::NewFrame().
+        bool update(vsg::Context& context);
+
+        struct DynamicGlyphStats
+        {
+            uint32_t numGlyphs = 0;        ///< glyphs rasterized into the dynamic region
+            uint32_t numMissingGlyphs = 0; ///< requested glyphs not available in any source font or that didn't fit in the dynamic region
+            uint32_t numUploads = 0;
+            uint32_t numUploadedRects = 0;
+            VkDeviceSize uploadedBytes = 0;
+        };
+
+        const DynamicGlyphStats& getDynamicGlyphStats() const { return _dynamicGlyphStats; }
+
+    protected:
+        virtual ~FontAtlas();
+
+        struct DynamicGlyphs;
+        std::unique_ptr<DynamicGlyphs> _dynamicGlyphs;
+        std::vector<std::pair<const ImFont*, ImWchar>> _pendingGlyphs;
+        std::mutex _glyphMutex;
+        DynamicGlyphStats _dynamicGlyphStats;
+        vsg::ref_ptr<vsg::ubvec4Array2D> _pixels;
+        int _dynamicRectIndex = -1;
+
+        void _setupDynamicGlyphs();
+        void _addPlaceholders();
+        bool _applyStagedGlyphs();
+
+        bool _readCache(const vsg::Path& filename);
+        bool _writeCache(const vsg::Path& filename) const;
+
+        uint32_t _deviceID = 0;
+        VkDescriptorSet _descriptorSet = VK_NULL_HANDLE;
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::FontAtlas);
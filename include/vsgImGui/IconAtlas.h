@@ -0,0 +1,100 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/nodes/Compilable.h>
+
+#include <vsgImGui/Texture.h>
+
+#include <memory>
+
+namespace vsgImGui
+{
+
+    /// IconAtlas packs many small RGBA images into one or more page Textures, using stb_rectpack, so a toolbar or tree view
+    /// of icons draws with a single ImTextureID and ImGui can batch them into a single draw call.
+    class VSGIMGUI_DECLSPEC IconAtlas : public vsg::Inherit<vsg::Compilable, IconAtlas>
+    {
+    public:
+        explicit IconAtlas(uint32_t in_pageWidth = 1024, uint32_t in_pageHeight = 1024, uint32_t in_padding = 1);
+
+        const uint32_t pageWidth;
+        const uint32_t pageHeight;
+
+        /// empty texels left between icons so linear filtering doesn't bleed neighbouring icons into each other
+        const uint32_t padding;
+
+        struct Icon
+        {
+            uint32_t page = 0;
+            ImVec2 size;
+            ImVec2 uv0;
+            ImVec2 uv1;
+            bool packed = false;
+        };
+
+        static constexpr uint32_t invalidIcon = ~0u;
+
+        /// add a 4 byte per texel image, e.g. vsg::ubvec4Array2D with VK_FORMAT_R8G8B8A8_UNORM, returning its index or invalidIcon if it can't be packed.
+        /// BGRA images are swizzled to the pages' VK_FORMAT_R8G8B8A8_UNORM and sRGB images copied with their encoded values, as ImGui's own colours are,
+        /// other formats are rejected.
+        uint32_t add(vsg::ref_ptr<vsg::Data> image);
+
+        /// pack the icons added since the last pack() into the pages, called by compile(..). Icons packed into already compiled pages
+        /// mark the page Texture dirty, so record an UpdateTextures holding the pages to upload them. Icons that don't fit are packed into
+        /// new pages, which aren't compiled until the next compile(..), so until then their id() is null and they aren't drawn.
+        void pack();
+
+        /// pack any new icons and compile the page Textures, including pages added by pack() since the last compile(..).
+        void compile(vsg::Context& context) override;
+
+        size_t numIcons() const { return _icons.size(); }
+        const Icon& icon(uint32_t index) const { return _icons[index]; }
+
+        /// ImTextureID of the page holding the icon, null for invalidIcon, icons that haven't been packed and icons on pages that haven't been compiled.
+        ImTextureID id(uint32_t index, uint32_t deviceID) const;
+
+        /// convenience wrapper around ImGui::Image(..), size defaults to the icon's size in pixels.
+        void image(uint32_t index, uint32_t deviceID, const ImVec2& size = ImVec2(0.0f, 0.0f)) const;
+
+        /// page Textures, pass them to RenderImGui::addTexture(..) when the UI is rendered on several devices or with bindless textures.
+        std::vector<vsg::ref_ptr<Texture>> pages;
+
+    protected:
+        virtual ~IconAtlas();
+
+        std::vector<Icon> _icons;
+        std::vector<vsg::ref_ptr<vsg::Data>> _pendingImages; // images not yet packed, indexed as _icons
+        std::vector<vsg::ref_ptr<vsg::Data>> _pageData;
+        std::vector<bool> _compiledPages;
+
+        struct Packers;
+        std::unique_ptr<Packers> _packers;
+
+        void _addPage();
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::IconAtlas);
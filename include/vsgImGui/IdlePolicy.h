@@ -0,0 +1,71 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Inherit.h>
+#include <vsg/core/Object.h>
+
+#include <vsgImGui/Export.h>
+
+#include <atomic>
+
+namespace vsgImGui
+{
+
+    /// IdlePolicy decides when RenderImGui needs to rebuild the UI. When assigned to RenderImGui::idlePolicy and SendEventsToImGui::idlePolicy,
+    /// frames without input activity or redraw requests skip ImGui::NewFrame()/Render() and the GUI callbacks, replaying the last ImDrawData.
+    class VSGIMGUI_DECLSPEC IdlePolicy : public vsg::Inherit<vsg::Object, IdlePolicy>
+    {
+    public:
+        explicit IdlePolicy(uint32_t in_framesAfterActivity = 30);
+
+        /// number of frames to keep rebuilding the UI after input activity, so hover delays, fades and focus changes can complete.
+        uint32_t framesAfterActivity = 30;
+
+        /// keep rebuilding while ImGui has an active text input so the cursor blinks.
+        bool redrawWhileTextInput = true;
+
+        /// called by SendEventsToImGui when input is passed to ImGui.
+        void activity() { requestRedraw(framesAfterActivity); }
+
+        /// request that the UI be rebuilt for at least the next numFrames frames, for use by animated widgets.
+        void requestRedraw(uint32_t numFrames = 1);
+
+        /// called once per frame by RenderImGui, returns true if the UI should be rebuilt and updates the counters.
+        bool update();
+
+        uint64_t getNumUpdatedFrames() const { return _numUpdatedFrames.load(); }
+        uint64_t getNumSkippedFrames() const { return _numSkippedFrames.load(); }
+
+    protected:
+        virtual ~IdlePolicy();
+
+        std::atomic<uint32_t> _framesRemaining;
+        std::atomic<uint64_t> _numUpdatedFrames{0};
+        std::atomic<uint64_t> _numSkippedFrames{0};
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::IdlePolicy);
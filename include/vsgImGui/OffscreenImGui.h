@@ -0,0 +1,125 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/RenderGraph.h>
+#include <vsg/app/Window.h>
+#include <vsg/state/ImageView.h>
+#include <vsg/state/Sampler.h>
+
+#include <vsgImGui/RenderImGui.h>
+
+#include <list>
+
+namespace vsgImGui
+{
+
+    class CompositeImGui;
+
+    /// OffscreenImGui renders a RenderImGui's UI into its own color image, only re-rendering when the UI's ImDrawData has changed. Assign renderImGui->idlePolicy
+    /// so idle frames skip rebuilding the UI altogether, without one the UI is rebuilt and its ImDrawData hashed every frame,
+    /// and provides a CompositeImGui node that blends the image into the main render pass with a single full screen draw.
+    /// Add the OffscreenImGui to the CommandGraph before the window's RenderGraph, and the node returned by createComposite() to that RenderGraph after the View.
+    class VSGIMGUI_DECLSPEC OffscreenImGui : public vsg::Inherit<vsg::Node, OffscreenImGui>
+    {
+    public:
+        /// create the offscreen layer for window, format defaults to the window's surface format so blending and sRGB handling match rendering to the window directly.
+        explicit OffscreenImGui(const vsg::ref_ptr<vsg::Window>& window, VkFormat format = VK_FORMAT_UNDEFINED);
+
+        /// RenderImGui that renders to the offscreen image, add the GUI components to it in the same way as a RenderImGui placed in the main pass.
+        vsg::ref_ptr<RenderImGui> renderImGui;
+
+        /// create the node that composites the UI image into the window's render pass.
+        vsg::ref_ptr<CompositeImGui> createComposite();
+
+        struct Stats
+        {
+            uint64_t numRenderedFrames = 0;  // frames where the UI was rendered to the offscreen image
+            uint64_t numSkippedFrames = 0;   // frames where the offscreen image was reused
+            uint64_t numUnchangedFrames = 0; // skipped frames where the UI was rebuilt but its ImDrawData was unchanged
+            bool hasIdlePolicy = false;      // false when renderImGui has no IdlePolicy, so the UI is rebuilt and compared every frame
+        };
+
+        Stats getStats() const { return _stats; }
+
+        void traverse(vsg::Visitor& visitor) override;
+        void traverse(vsg::ConstVisitor& visitor) const override;
+
+        /// build the UI and, if its ImDrawData has changed, render it to the offscreen image.
+        void accept(vsg::RecordTraversal& rt) const override;
+
+        /// record the blend of the offscreen image into the current render pass, called by CompositeImGui.
+        void composite(vsg::RecordTraversal& rt) const;
+
+    protected:
+        virtual ~OffscreenImGui();
+
+        void _resize(const VkExtent2D& extent, uint64_t frameCount) const;
+        void _releaseRetired(uint64_t frameCount) const;
+
+        vsg::ref_ptr<vsg::Window> _window;
+        vsg::ref_ptr<vsg::Device> _device;
+        vsg::ref_ptr<vsg::RenderPass> _renderPass;
+        vsg::ref_ptr<vsg::Context> _context;
+        vsg::ref_ptr<vsg::Context> _compositeContext;
+        vsg::ref_ptr<BindCachedGraphicsPipeline> _bindCompositePipeline;
+        vsg::ref_ptr<vsg::RenderGraph> _renderGraph;
+        vsg::ref_ptr<vsg::Sampler> _sampler;
+        VkFormat _format = VK_FORMAT_UNDEFINED;
+        uint32_t _numFramesInFlight = 3;
+
+        // resources replaced by a resize, kept until the frames in flight that may be using them have completed
+        struct Retired
+        {
+            uint64_t frameCount = 0;
+            vsg::ref_ptr<vsg::ImageView> imageView;
+            vsg::ref_ptr<vsg::Framebuffer> framebuffer;
+            VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        };
+        mutable std::list<Retired> _retired;
+
+        mutable vsg::ref_ptr<vsg::ImageView> _imageView;
+        mutable VkDescriptorSet _descriptorSet = VK_NULL_HANDLE;
+        mutable VkExtent2D _extent = {0, 0};
+        mutable bool _imageValid = false;
+        mutable uint64_t _fingerprint = 0;
+        mutable Stats _stats;
+    };
+
+    /// CompositeImGui blends an OffscreenImGui's image over the contents of the render pass it's recorded in.
+    class VSGIMGUI_DECLSPEC CompositeImGui : public vsg::Inherit<vsg::Node, CompositeImGui>
+    {
+    public:
+        explicit CompositeImGui(vsg::ref_ptr<OffscreenImGui> in_offscreenImGui) :
+            offscreenImGui(in_offscreenImGui) {}
+
+        vsg::ref_ptr<OffscreenImGui> offscreenImGui;
+
+        void accept(vsg::RecordTraversal& rt) const override { offscreenImGui->composite(rt); }
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::OffscreenImGui);
+EVSG_type_name(vsgImGui::CompositeImGui);
@@ -0,0 +1,67 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/observer_ptr.h>
+#include <vsg/nodes/Node.h>
+#include <vsg/ui/FrameStamp.h>
+
+#include <vsgImGui/RenderImGui.h>
+
+#include <optional>
+
+namespace vsgImGui
+{
+
+    /// PerformanceOverlay is a child for RenderImGui that draws an overlay plotting the frame time and the UI's draw calls with ImPlot,
+    /// along with the UI's GPU time, the rolling average of the timed frames, when RenderImGui::setupTimestamps(..) has been called. Samples are kept in ring buffers allocated up front
+    /// so the per frame cost is fixed. Frames skipped by an IdlePolicy aren't sampled.
+    class VSGIMGUI_DECLSPEC PerformanceOverlay : public vsg::Inherit<vsg::Node, PerformanceOverlay>
+    {
+    public:
+        explicit PerformanceOverlay(vsg::ref_ptr<RenderImGui> in_renderImGui = {}, uint32_t in_numSamples = 240);
+
+        /// RenderImGui whose render stats are plotted, observed to avoid a reference cycle with its children.
+        vsg::observer_ptr<RenderImGui> renderImGui;
+
+        /// corner of the display the overlay is placed in, 0 top-left, 1 top-right, 2 bottom-left, 3 bottom-right.
+        int corner = 1;
+        bool visible = true;
+
+        void accept(vsg::RecordTraversal& rt) const override;
+
+    protected:
+        virtual ~PerformanceOverlay();
+
+        mutable std::vector<float> _frameTimes;
+        mutable std::vector<float> _drawCalls;
+        mutable std::vector<float> _gpuTimes;
+        mutable int _offset = 0;
+        mutable int _count = 0;
+        mutable std::optional<vsg::time_point> _previousTime;
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::PerformanceOverlay);
@@ -0,0 +1,102 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Path.h>
+#include <vsg/state/GraphicsPipeline.h>
+#include <vsg/vk/Device.h>
+
+#include <vsgImGui/Export.h>
+
+namespace vsgImGui
+{
+
+    /// PipelineCache wraps a VkPipelineCache that can be read from and written to file, so that pipelines compiled in
+    /// earlier runs don't need to be compiled again. The file is tagged with the device's UUIDs and driver version, and
+    /// data written for a different device or driver is ignored.
+    class VSGIMGUI_DECLSPEC PipelineCache : public vsg::Inherit<vsg::Object, PipelineCache>
+    {
+    public:
+        explicit PipelineCache(vsg::ref_ptr<vsg::Device> in_device, const vsg::Path& in_filename = {});
+
+        const vsg::ref_ptr<vsg::Device> device;
+
+        /// file that the cache is read from on construction and written to by write().
+        vsg::Path filename;
+
+        VkPipelineCache vk() const { return _pipelineCache; }
+        operator VkPipelineCache() const { return _pipelineCache; }
+
+        /// write the current contents of the cache to filename, via a temporary file that is renamed into place so readers never see a partial file. Return true on success.
+        bool write() const;
+
+    protected:
+        virtual ~PipelineCache();
+
+        std::vector<uint8_t> _read() const;
+
+        VkPipelineCache _pipelineCache = VK_NULL_HANDLE;
+    };
+
+    /// BindCachedGraphicsPipeline binds a graphics pipeline in the same way as vsg::BindGraphicsPipeline,
+    /// but creates the VkPipeline using an optional PipelineCache, which vsg::GraphicsPipeline doesn't expose.
+    /// compile(..) mirrors vsg::GraphicsPipeline::compile(..) and GraphicsPipeline::Implementation from VulkanSceneGraph 1.1.10,
+    /// so check it against upstream changes to pipeline creation when moving to a newer VSG. Shaders must be provided as SPIR-V.
+    class VSGIMGUI_DECLSPEC BindCachedGraphicsPipeline : public vsg::Inherit<vsg::StateCommand, BindCachedGraphicsPipeline>
+    {
+    public:
+        explicit BindCachedGraphicsPipeline(vsg::ref_ptr<vsg::GraphicsPipeline> in_pipeline = {}, vsg::ref_ptr<PipelineCache> in_pipelineCache = {});
+
+        /// pipeline layout, shader stages and pipeline states used to create the VkPipeline
+        vsg::ref_ptr<vsg::GraphicsPipeline> pipeline;
+        vsg::ref_ptr<PipelineCache> pipelineCache;
+
+        VkPipeline vk(uint32_t deviceID) const { return deviceID < _implementation.size() ? _implementation[deviceID].pipeline : VK_NULL_HANDLE; }
+
+        /// return true if compiling the pipeline for the device failed, compile(..) doesn't retry until release() is called.
+        bool failed(uint32_t deviceID) const { return deviceID < _implementation.size() && _implementation[deviceID].failed; }
+
+        void compile(vsg::Context& context) override;
+
+        /// bind the pipeline, nothing is recorded if it hasn't been compiled successfully for the command buffer's device.
+        void record(vsg::CommandBuffer& commandBuffer) const override;
+        void release();
+
+    protected:
+        virtual ~BindCachedGraphicsPipeline();
+
+        struct Implementation
+        {
+            vsg::ref_ptr<vsg::Device> device;
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            bool failed = false;
+        };
+
+        std::vector<Implementation> _implementation;
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::PipelineCache);
+EVSG_type_name(vsgImGui::BindCachedGraphicsPipeline);
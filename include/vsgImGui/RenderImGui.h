@@ -24,27 +24,45 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 </editor-fold> */
 
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 
+#include <vsg/app/SecondaryCommandGraph.h>
 #include <vsg/app/Window.h>
 #include <vsg/commands/ClearAttachments.h>
 #include <vsg/nodes/Group.h>
-#include <vsg/vk/DescriptorPool.h>
+#include <vsg/vk/Context.h>
 
+#include <vsgImGui/DescriptorPools.h>
+#include <vsgImGui/DrawDataRenderer.h>
+#include <vsgImGui/DrawDataSnapshot.h>
 #include <vsgImGui/Export.h>
+#include <vsgImGui/FontAtlas.h>
+#include <vsgImGui/IdlePolicy.h>
 #include <vsgImGui/imgui.h>
 
+struct ImPlotContext;
+
 namespace vsgImGui
 {
+    class Texture;
 
+    /// RenderImGui builds and records the UI of its children, each RenderImGui has its own ImGuiContext and ImPlotContext
+    /// which are made current automatically when it's traversed, so multiple windows can each have their own RenderImGui.
     class VSGIMGUI_DECLSPEC RenderImGui : public vsg::Inherit<vsg::Group, RenderImGui>
     {
     public:
         RenderImGui(const vsg::ref_ptr<vsg::Window>& window, bool useClearAttachments = false);
 
+        /// create a RenderImGui whose ImGuiContext shares sharedFontAtlas, which must be on the same device, avoiding building and uploading the fonts for each window.
+        RenderImGui(const vsg::ref_ptr<vsg::Window>& window, vsg::ref_ptr<FontAtlas> sharedFontAtlas, bool useClearAttachments = false);
+
         RenderImGui(vsg::ref_ptr<vsg::Device> device, uint32_t queueFamily,
                     vsg::ref_ptr<vsg::RenderPass> renderPass,
                     uint32_t minImageCount, uint32_t imageCount,
-                    VkExtent2D imageSize, bool useClearAttachments = false);
+                    VkExtent2D imageSize, bool useClearAttachments = false,
+                    vsg::ref_ptr<FontAtlas> sharedFontAtlas = {});
 
         template<typename... Args>
         RenderImGui(const vsg::ref_ptr<vsg::Window>& window, Args&&... args) :
@@ -63,30 +81,209 @@ namespace vsgImGui
         /// std::function signature used for older vsgImGui versions
         using LegacyFunction = std::function<bool()>;
 
-        /// add a GUI rendering component that provides the ImGui calls to render the required GUI elements.
-        void add(const LegacyFunction& legacyFunc);
+        /// add a GUI rendering component that provides the ImGui calls to render the required GUI elements, the optional name is reported by getChildTimings().
+        void add(const LegacyFunction& legacyFunc, const std::string& name = {});
 
         /// add a child, equivalent to Group::addChild(..) but adds compatibility with the RenderImGui constructor
         void add(vsg::ref_ptr<vsg::Node> child) { addChild(child); }
 
+        /// assign a PipelineCache used when compiling the UI pipeline, must be assigned before the RenderImGui is compiled.
+        void setPipelineCache(vsg::ref_ptr<PipelineCache> pipelineCache);
+
+        /// convenience method for creating a PipelineCache for the device that is read from and, on destruction of the RenderImGui, written to filename.
+        void setPipelineCache(const vsg::Path& filename);
+
+        /// make this RenderImGui's ImGuiContext and ImPlotContext current on the calling thread. Use a ContextScope when the UI may be built on another thread.
+        void makeCurrent() const;
+
+        /// ContextScope locks a RenderImGui's contexts, so only one thread uses them at a time, and makes them current on the calling thread,
+        /// restoring the thread's previously current contexts on destruction. Used by build(..), record(..) and SendEventsToImGui, and by
+        /// applications calling ImGui for the RenderImGui from other threads. A null RenderImGui leaves the current contexts as they are.
+        class VSGIMGUI_DECLSPEC ContextScope
+        {
+        public:
+            explicit ContextScope(const RenderImGui* renderImGui);
+            ContextScope(const ContextScope&) = delete;
+            ContextScope& operator=(const ContextScope&) = delete;
+            ~ContextScope();
+
+        protected:
+            std::unique_lock<std::recursive_mutex> _lock;
+            ImGuiContext* _previousImGuiContext = nullptr;
+            ImPlotContext* _previousImPlotContext = nullptr;
+        };
+
+        ImGuiContext* getImGuiContext() const { return _imguiContext; }
+        ImPlotContext* getImPlotContext() const { return _implotContext; }
+
+        /// DrawDataRenderer used to record the ImDrawData, provides control and stats of the vertex/index buffers.
+        /// Its settings are copied to the renderers of the devices added by addWindow(..) when they are compiled, so set them before viewer->compile().
+        DrawDataRenderer* getRenderer() { return _renderer.get(); }
+        const DrawDataRenderer* getRenderer() const { return _renderer.get(); }
+
+        /// time the UI's GPU rendering on the primary device with timestamp queries, see DrawDataRenderer::setupTimestamps(..).
+        /// Requires the hostQueryReset feature to be enabled in the window's WindowTraits::deviceFeatures.
+        void setupTimestamps(uint32_t windowSize = 120) { _renderer->setupTimestamps(windowSize, _deviceFeatures.get()); }
+
+        /// rolling GPU time, draw call, vertex, index and texture bind stats of the frames timed since setupTimestamps(..) was called.
+        DrawDataRenderer::TimingStats getTimingStats() const { return _renderer->getTimingStats(); }
+
+        /// time each child's accept(..) with a steady clock when the UI is built, keeping the last windowSize samples of each child. Without it children are traversed untimed.
+        void setupChildTiming(uint32_t windowSize = 256);
+
+        struct ChildTiming
+        {
+            size_t index = 0;
+            std::string name; // the child's "name" value, or its className() when not set
+            uint64_t numSamples = 0; // total samples, the percentiles cover the most recent windowSize
+            double last = 0.0;       // milliseconds
+            double average = 0.0;
+            double p50 = 0.0;
+            double p95 = 0.0;
+            double p99 = 0.0;
+            double max = 0.0;
+        };
+
+        /// timings of each child since setupChildTiming(..) was called, safe to call while the UI is being built.
+        std::vector<ChildTiming> getChildTimings() const;
+
+        /// optional policy for skipping the rebuild of the UI on idle frames, share the same IdlePolicy with SendEventsToImGui::idlePolicy.
+        vsg::ref_ptr<IdlePolicy> idlePolicy;
+
+        /// DescriptorPools used to allocate the ImTextureID descriptor sets owned by the RenderImGui, provides stats on allocated/free sets.
+        DescriptorPools* getDescriptorPools() { return _descriptorPools.get(); }
+        const DescriptorPools* getDescriptorPools() const { return _descriptorPools.get(); }
+
+        /// FontAtlas used to upload io.Fonts, compiled along with the scene graph by viewer->compile(). Pass to other RenderImGui constructors to share the fonts.
+        FontAtlas* getFontAtlas() { return _fontAtlas.get(); }
+        const FontAtlas* getFontAtlas() const { return _fontAtlas.get(); }
+
+        /// add the resources required to render the UI into window when it's on a different device to the RenderImGui's primary device,
+        /// the UI is then rendered on every device that the RenderImGui is recorded for. Call before viewer->compile() so the resources are compiled along
+        /// with the scene graph, otherwise the UI is only rendered on the device once the transfers submitted by the record traversal have completed.
+        /// Not supported when the FontAtlas uses dynamicGlyphs, as the glyphs added at runtime are only uploaded to the primary device.
+        void addWindow(const vsg::ref_ptr<vsg::Window>& window);
+
+        /// register a Texture used by the UI, so the ImTextureID returned by texture->id(..) for the primary device can be mapped to the other devices' descriptor sets.
+        void addTexture(vsg::ref_ptr<Texture> texture);
+
+        /// draw the font atlas and the Textures passed to addTexture(..) from a single bindless descriptor array, see DrawDataRenderer::setupBindlessTextures(..).
+        /// Call before the RenderImGui is compiled.
+        void setupBindlessTextures(uint32_t maxTextures = 1024);
+
+        /// create a vsg::SecondaryCommandGraph for window's subpass containing this RenderImGui, so the UI is recorded into a secondary command buffer on
+        /// its own thread once viewer->setupThreading() is called. Assign the returned graph along with the primary CommandGraph via
+        /// viewer->assignRecordAndSubmitTaskAndPresentation(..), and add a vsg::ExecuteCommands connected to it to the RenderGraph in place of the RenderImGui.
+        /// Vulkan only allows vkCmdExecuteCommands in a subpass recorded with secondary command buffers, so the RenderGraph's contents must be
+        /// VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS and the scene needs its own SecondaryCommandGraph, executed before the UI's.
+        vsg::ref_ptr<vsg::SecondaryCommandGraph> createSecondaryCommandGraph(vsg::ref_ptr<vsg::Window> window, uint32_t subpass = 0);
+
+        using vsg::Group::traverse;
+        void traverse(vsg::Visitor& visitor) override;
+
+        /// build the UI, calling ImGui::NewFrame(), traversing the children and calling ImGui::Render(), skipped on idle frames when an idlePolicy is assigned
+        /// and, when the viewer hasn't compiled the RenderImGui, until the font atlas transfer submitted by the first build has completed.
+        /// Returns true if the ImDrawData was rebuilt.
+        bool build(vsg::RecordTraversal& rt) const;
+
+        /// record the current ImDrawData, unchanged signals that it hasn't been rebuilt since the last call to record(..).
+        void record(vsg::RecordTraversal& rt, bool unchanged) const;
+
+        /// build and record the UI, equivalent to record(rt, !build(rt)). When a build thread is running only the latest DrawDataSnapshot is recorded.
         void accept(vsg::RecordTraversal& rt) const override;
 
+        struct BuiltFrame
+        {
+            uint64_t fingerprint = 0; // DrawDataRenderer::fingerprint(..) of the ImDrawData accept(..) records for the frame, 0 when there's nothing to record
+            bool rebuilt = false;     // the ImDrawData is new since the previous call
+        };
+
+        /// build the UI for the traversal's frame as accept(..) does, only once per frame however many times it's called and requesting the build from the build
+        /// thread when one is running, without recording it. Used by OffscreenImGui to decide whether the UI needs recording before calling accept(..) on the same frame.
+        BuiltFrame buildFrame(vsg::RecordTraversal& rt) const;
+
+        /// start a thread that builds the UI each frame, against the input received up to the previous frame, and publishes a DrawDataSnapshot for accept() to record,
+        /// taking the GUI callbacks off the record thread at the cost of the UI lagging a frame behind. Children are traversed by a RecordTraversal without a command buffer,
+        /// so only vsg::Command children that just call ImGui, the add(LegacyFunction) callbacks and PerformanceOverlay are built, other nodes are skipped.
+        void setupBuildThread();
+
+        /// stop the build thread, call when the RenderImGui isn't being recorded. accept() then goes back to building the UI itself.
+        void stopBuildThread();
+
+        bool hasBuildThread() const { return static_cast<bool>(_buildThread); }
+
     private:
         virtual ~RenderImGui();
 
+        ImGuiContext* _imguiContext = nullptr;
+        ImPlotContext* _implotContext = nullptr;
+        mutable std::recursive_mutex _contextMutex;
+
         vsg::ref_ptr<vsg::Device> _device;
+        vsg::ref_ptr<vsg::DeviceFeatures> _deviceFeatures; // the features the window's device was created with, when known
         uint32_t _queueFamily;
         vsg::ref_ptr<vsg::Queue> _queue;
-        vsg::ref_ptr<vsg::DescriptorPool> _descriptorPool;
+        vsg::ref_ptr<DescriptorPools> _descriptorPools;
+        vsg::ref_ptr<vsg::Context> _context;
+        vsg::ref_ptr<DrawDataRenderer> _renderer;
+
+        vsg::ref_ptr<FontAtlas> _fontAtlas;
 
         vsg::ref_ptr<vsg::ClearAttachments> _clearAttachments;
 
-        void _init(const vsg::ref_ptr<vsg::Window>& window, bool useClearAttachments);
+        struct DeviceResources
+        {
+            vsg::ref_ptr<vsg::Device> device;
+            vsg::ref_ptr<DescriptorPools> descriptorPools;
+            vsg::ref_ptr<vsg::Context> context;
+            vsg::ref_ptr<DrawDataRenderer> renderer;
+            vsg::ref_ptr<FontAtlas> fontAtlas;
+            size_t numCompiledTextures = 0;
+            bool uploadPending = false; // transfer submitted on context by the record fallback
+            bool ready = false;         // all the resources are compiled and the renderer's textureMap is up to date
+        };
+
+        // per device resources for devices other than _device, indexed by deviceID. Set up by addWindow(..) and compiled by the CompileTraversal,
+        // the record traversals only look them up. Held by unique_ptr so the pointers handed to record remain valid when other devices are added.
+        mutable std::mutex _devicesMutex;
+        std::vector<std::unique_ptr<DeviceResources>> _additionalDevices;
+        std::vector<vsg::ref_ptr<Texture>> _textures;
+
+        mutable std::mutex _recordMutex;
+        mutable std::optional<uint64_t> _builtFrame;
+        mutable std::optional<uint64_t> _rebuiltFrame;                   // frame of the most recent build(..) that produced new ImDrawData
+        mutable std::vector<std::optional<uint64_t>> _uploadedFrames; // per deviceID, the rebuilt frame whose ImDrawData was last uploaded
+        mutable std::optional<uint64_t> _fingerprintedFrame;          // the rebuilt frame, or with a build thread the snapshot, that _fingerprint was computed for
+        mutable vsg::ref_ptr<DrawDataSnapshot> _fingerprintedSnapshot;
+        mutable uint64_t _fingerprint = 0;
+        mutable bool _warnedUnknownDevice = false;
+        mutable bool _warnedBuildThreadChild = false;
+        mutable bool _fontUploadPending = false; // _compile() and _context are only used by the record thread when a build thread is running
+
+        struct BuildThread;
+        std::unique_ptr<BuildThread> _buildThread;
+
+        struct ChildTimings;
+        std::unique_ptr<ChildTimings> _childTimings;
+        mutable std::vector<vsg::ref_ptr<DrawDataSnapshot>> _recordedSnapshots;
+
+        const DeviceResources* _getAdditionalDevice(vsg::CommandBuffer& commandBuffer) const;
+        void _compileAdditionalDevice(DeviceResources& resources, vsg::Context* context) const;
+
+        void _init(const vsg::ref_ptr<vsg::Window>& window, bool useClearAttachments, vsg::ref_ptr<FontAtlas> sharedFontAtlas);
         void _init(vsg::ref_ptr<vsg::Device> device, uint32_t queueFamily,
                    vsg::ref_ptr<vsg::RenderPass> renderPass,
                    uint32_t minImageCount, uint32_t imageCount,
-                   VkExtent2D imageSize, bool useClearAttachments);
-        void _uploadFonts();
+                   VkExtent2D imageSize, bool useClearAttachments,
+                   vsg::ref_ptr<FontAtlas> sharedFontAtlas);
+        bool _compile() const;
+        void _record(vsg::RecordTraversal& rt, const DeviceResources* resources, ImDrawData* drawData, bool unchanged) const;
+        void _addBindlessTextures(DrawDataRenderer& renderer, const FontAtlas& fontAtlas, uint32_t deviceID) const;
+        void _buildFrame(vsg::RecordTraversal& rt, uint64_t frameCount) const;
+        void _recordSnapshot(vsg::RecordTraversal& rt, const DeviceResources* resources) const;
+        void _runBuildThread() const;
+        void _traverseTimed(vsg::RecordTraversal& rt) const;
+        bool _buildable(const vsg::Node& child, const vsg::RecordTraversal& rt) const;
     };
 
     // temporary workaround for Dear ImGui's nonexistent sRGB awareness
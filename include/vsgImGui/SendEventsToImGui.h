@@ -26,16 +26,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <chrono>
 
 #include <vsg/core/Visitor.h>
+#include <vsg/ui/WindowEvent.h>
 #include <vsg/ui/KeyEvent.h>
 
 #include <vsgImGui/RenderImGui.h>
 
 namespace vsgImGui
 {
+    /// SendEventsToImGui passes vsg::UIEvents to ImGui. When constructed with a window and RenderImGui, only the window's events
+    /// are passed on, with the RenderImGui's contexts made current first, so each window of a multi-window viewer has its own instance.
     class VSGIMGUI_DECLSPEC SendEventsToImGui : public vsg::Inherit<vsg::Visitor, SendEventsToImGui>
     {
     public:
         SendEventsToImGui();
+        SendEventsToImGui(vsg::ref_ptr<vsg::Window> in_window, vsg::ref_ptr<RenderImGui> in_renderImGui);
+
+        /// when set only events from this window are passed to ImGui
+        vsg::observer_ptr<vsg::Window> window;
+
+        /// when set the RenderImGui's contexts are made current before events are passed to ImGui
+        vsg::ref_ptr<RenderImGui> renderImGui;
 
         void apply(vsg::ButtonPressEvent& buttonPress) override;
         void apply(vsg::ButtonReleaseEvent& buttonRelease) override;
@@ -46,6 +56,9 @@ namespace vsgImGui
         void apply(vsg::ConfigureWindowEvent& configureWindow) override;
         void apply(vsg::FrameEvent& frame) override;
 
+        /// optional policy that is notified of input activity, share the same IdlePolicy with RenderImGui::idlePolicy.
+        vsg::ref_ptr<IdlePolicy> idlePolicy;
+
     protected:
         ~SendEventsToImGui();
 
@@ -57,6 +70,14 @@ namespace vsgImGui
         bool _dragging;
 
         std::map<vsg::KeySymbol, ImGuiKey> _vsg2imgui;
+
+        void _activity()
+        {
+            if (idlePolicy) idlePolicy->activity();
+        }
+
+        /// return false if the event is for another window.
+        bool _acceptEvent(const vsg::WindowEvent& event) const;
     };
 } // namespace vsgImGui
 
@@ -25,28 +25,72 @@ SOFTWARE.
 #pragma once
 
 #include <vsg/nodes/Compilable.h>
+#include <vsg/state/ImageInfo.h>
 #include <vsg/state/Sampler.h>
 
 #include <vsgImGui/RenderImGui.h>
 
+#include <mutex>
+
 namespace vsgImGui
 {
     /// Texture adapter that uses a DescriptorSet/DescriptorImage to hold a texture image on the GPU in a form that ImGui can use.
     class VSGIMGUI_DECLSPEC Texture : public vsg::Inherit<vsg::Compilable, Texture>
     {
     public:
-        Texture(vsg::ref_ptr<vsg::Data> data = {}, vsg::ref_ptr<vsg::Sampler> sampler = {});
+        /// data may be uncompressed or block compressed (BC/ETC2/ASTC), block compressed data is uploaded as is along with any mip levels it contains,
+        /// its sampler's maxLod being clamped to those levels as they can't be generated. When no sampler is provided a default one is used, with the full
+        /// mip chain generated on upload for uncompressed data when generateMipmaps is true, so images drawn smaller than their native size, such as
+        /// thumbnails, don't alias. Provided samplers are copied and control mipmapping through their maxLod.
+        Texture(vsg::ref_ptr<vsg::Data> data = {}, vsg::ref_ptr<vsg::Sampler> sampler = {}, bool generateMipmaps = true);
 
         void compile(vsg::Context& context) override;
 
         /// get the ImTextureID used with ImGui::Image(..) calls
         ImTextureID id(uint32_t deviceID) const;
 
+        /// ImageInfo of the descriptor set's image
+        vsg::ref_ptr<vsg::ImageInfo> getImageInfo() const;
+
+        /// replace descriptorSet with an uncompiled equivalent for the same data and sampler, so the GPU image is freed once the returned descriptor set,
+        /// which frames in flight may still be using, is released. A subsequent compile(..) re-creates the GPU resources with a new ImTextureID.
+        vsg::ref_ptr<vsg::DescriptorSet> release();
+
+        /// return true if the device can sample images of the specified format, use to choose between BC and ETC2 compressed data.
+        static bool isFormatSupported(vsg::Device& device, VkFormat format);
+
         vsg::ref_ptr<vsg::DescriptorSet> descriptorSet;
-        uint32_t height = 0;
+        uint32_t height = 0; // in texels, including for block compressed data
         uint32_t width = 0;
 
+        /// mark the whole image, or a region of it, as modified in the data passed to the constructor. The dirty regions are copied to the GPU,
+        /// reusing the existing image and descriptor set, by the next UpdateTextures::record(..) the Texture is assigned to, separately for each device.
+        /// Only the base mip level is updated, so construct Textures that are updated with generateMipmaps = false, or a sampler with maxLod = 0.
+        /// Block compressed Textures can't be updated, their dirty regions are discarded with a warning.
+        void dirty();
+        void dirty(const VkRect2D& region);
+
+        /// mark a region as modified for just the specified device, used by UpdateTextures to return regions it was unable to copy.
+        void dirty(uint32_t deviceID, const VkRect2D& region);
+
+        /// when more regions than this are dirty they are merged into their bounding rectangle
+        size_t maxDirtyRegions = 16;
+
+        /// return and clear the specified device's dirty regions, clamped to the image, called by UpdateTextures.
+        std::vector<VkRect2D> takeDirtyRegions(uint32_t deviceID);
+
     protected:
         virtual ~Texture();
+
+        struct DirtyRegions
+        {
+            bool tracked = false; // set once the image has been compiled for the device
+            std::vector<VkRect2D> regions;
+        };
+
+        std::mutex _dirtyMutex;
+        std::vector<DirtyRegions> _dirtyRegions; // indexed by deviceID
+
+        void _addDirtyRegion(std::vector<VkRect2D>& regions, const VkRect2D& region) const;
     };
 } // namespace vsgImGui
@@ -0,0 +1,115 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Inherit.h>
+#include <vsg/core/Object.h>
+#include <vsg/vk/Context.h>
+
+#include <vsgImGui/Texture.h>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace vsgImGui
+{
+
+    /// TextureResidency keeps the GPU memory of Textures that are only occasionally shown, e.g. in image browsers, bounded. Textures are uploaded
+    /// on first use and released, least recently used first, once unused for maxUnusedFrames frames or while the resident images exceed the budget.
+    /// Released Textures get a new ImTextureID when next used, so don't register them with RenderImGui::addTexture(..).
+    class VSGIMGUI_DECLSPEC TextureResidency : public vsg::Inherit<vsg::Object, TextureResidency>
+    {
+    public:
+        /// context used to compile Textures on demand, the ImTextureIDs returned are for its device.
+        explicit TextureResidency(vsg::ref_ptr<vsg::Context> in_context, uint32_t in_numFramesInFlight = 3);
+
+        vsg::ref_ptr<vsg::Context> context;
+
+        /// frames a Texture may go unused before it's released, 0 to disable.
+        uint64_t maxUnusedFrames = 600;
+
+        /// bytes of image data to keep resident, 0 for no limit.
+        VkDeviceSize budget = 0;
+
+        /// drawn in place of Textures whose upload hasn't completed, uploaded along with the first of them. Until that upload has completed, or when null, nothing is drawn.
+        vsg::ref_ptr<Texture> placeholder;
+
+        /// return the Texture's ImTextureID and mark it as used this frame. Call from the GUI callbacks in place of texture->id(deviceID).
+        /// Textures that aren't resident are queued for upload by update() and the placeholder's ImTextureID is returned until their upload has completed.
+        ImTextureID id(vsg::ref_ptr<Texture> texture);
+
+        /// advance to the next frame, poll the upload in flight without waiting for it, release the Textures that are out of date or over budget,
+        /// then submit the upload of the queued Textures once the previous upload has completed. Call once per frame.
+        void update();
+
+        struct Stats
+        {
+            uint64_t numHits = 0;
+            uint64_t numMisses = 0;
+            uint64_t numEvictions = 0;
+            uint64_t numUploads = 0;        // submissions by update()
+            uint32_t numResident = 0;       // including Textures queued or being uploaded
+            VkDeviceSize residentBytes = 0; // including the mip levels generated on the GPU
+        };
+
+        Stats getStats() const;
+
+    protected:
+        virtual ~TextureResidency();
+
+        struct Entry
+        {
+            vsg::ref_ptr<Texture> texture;
+            uint64_t lastUsedFrame = 0;
+            VkDeviceSize size = 0;
+            bool uploaded = false;
+        };
+
+        using LRU = std::list<Entry>; // most recently used at the front
+
+        uint32_t _numFramesInFlight;
+        uint64_t _frameCount = 0;
+        LRU _lru;
+        std::unordered_map<const Texture*, LRU::iterator> _entries;
+
+        // Textures waiting for the next upload, and those in the upload submitted by update() that hasn't been seen to complete
+        std::vector<vsg::ref_ptr<Texture>> _queued;
+        std::vector<vsg::ref_ptr<Texture>> _uploading;
+        bool _placeholderCompiled = false; // submitted with the upload of the Textures
+        bool _placeholderUploaded = false; // that upload has completed, so the placeholder can be drawn
+
+        // released descriptor sets are kept until the frames that may be using them have completed
+        std::list<std::pair<uint64_t, vsg::ref_ptr<vsg::DescriptorSet>>> _released;
+
+        mutable std::mutex _mutex;
+        Stats _stats;
+
+        bool _evict(LRU::iterator itr);
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::TextureResidency);
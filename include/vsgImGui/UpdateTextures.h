@@ -0,0 +1,75 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/Command.h>
+#include <vsg/state/Buffer.h>
+
+#include <vsgImGui/Texture.h>
+
+namespace vsgImGui
+{
+
+    /// UpdateTextures copies the dirty regions of its Textures to their images via a ring of persistently mapped staging buffers,
+    /// one per frame in flight. It must be recorded outside a render pass, e.g. as a child of the CommandGraph placed before the RenderGraph.
+    class VSGIMGUI_DECLSPEC UpdateTextures : public vsg::Inherit<vsg::Command, UpdateTextures>
+    {
+    public:
+        explicit UpdateTextures(uint32_t in_numFrames = 3);
+
+        std::vector<vsg::ref_ptr<Texture>> textures;
+
+        struct Stats
+        {
+            uint64_t numUploads = 0;       // record(..) calls that copied data
+            uint64_t numUploadedRects = 0; // regions copied
+            uint64_t uploadedBytes = 0;
+        };
+
+        Stats getStats() const { return _stats; }
+
+        void record(vsg::CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~UpdateTextures();
+
+        struct StagingBuffer
+        {
+            vsg::ref_ptr<vsg::Buffer> buffer;
+            void* data = nullptr;
+            VkDeviceSize size = 0;
+            uint32_t deviceID = 0;
+        };
+
+        uint32_t _numFrames;
+        mutable std::vector<std::vector<StagingBuffer>> _staging; // indexed by deviceID then frame
+        mutable std::vector<size_t> _frameIndices; // indexed by deviceID
+        mutable Stats _stats;
+
+        void _release(StagingBuffer& staging) const;
+    };
+
+} // namespace vsgImGui
+
+EVSG_type_name(vsgImGui::UpdateTextures);
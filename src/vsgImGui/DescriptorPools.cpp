@@ -0,0 +1,108 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/DescriptorPools.h>
+
+#include <vsg/io/Logger.h>
+
+using namespace vsgImGui;
+
+DescriptorPools::DescriptorPools(vsg::ref_ptr<vsg::Device> in_device, uint32_t in_initialMaxSets) :
+    device(in_device),
+    initialMaxSets(std::max(in_initialMaxSets, 1u))
+{
+}
+
+DescriptorPools::~DescriptorPools()
+{
+}
+
+VkDescriptorSet DescriptorPools::allocate(VkDescriptorSetLayout descriptorSetLayout)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto allocateFrom = [&](size_t poolIndex) -> VkDescriptorSet {
+        auto& pool = _pools[poolIndex];
+
+        VkDescriptorSetAllocateInfo allocateInfo = {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.descriptorPool = *pool.descriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = &descriptorSetLayout;
+
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        if (vkAllocateDescriptorSets(*device, &allocateInfo, &descriptorSet) != VK_SUCCESS) return VK_NULL_HANDLE;
+
+        ++pool.numAllocatedSets;
+        _allocations[descriptorSet] = poolIndex;
+        return descriptorSet;
+    };
+
+    for (size_t i = 0; i < _pools.size(); ++i)
+    {
+        if (_pools[i].numAllocatedSets < _pools[i].maxSets)
+        {
+            if (auto descriptorSet = allocateFrom(i)) return descriptorSet;
+        }
+    }
+
+    // all the existing pools are full so chain a new one
+    uint32_t maxSets = _pools.empty() ? initialMaxSets : _pools.back().maxSets * 2;
+    vsg::DescriptorPoolSizes poolSizes{{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, maxSets}};
+
+    vsg::debug("vsgImGui::DescriptorPools::allocate() creating DescriptorPool with maxSets = ", maxSets);
+
+    _pools.push_back(Pool{vsg::DescriptorPool::create(device, maxSets, poolSizes), maxSets, 0});
+
+    auto descriptorSet = allocateFrom(_pools.size() - 1);
+    if (!descriptorSet) vsg::warn("vsgImGui::DescriptorPools::allocate() unable to allocate VkDescriptorSet.");
+    return descriptorSet;
+}
+
+void DescriptorPools::free(VkDescriptorSet descriptorSet)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto itr = _allocations.find(descriptorSet);
+    if (itr == _allocations.end()) return;
+
+    auto& pool = _pools[itr->second];
+    vkFreeDescriptorSets(*device, *pool.descriptorPool, 1, &descriptorSet);
+    --pool.numAllocatedSets;
+
+    _allocations.erase(itr);
+}
+
+DescriptorPools::Stats DescriptorPools::getStats() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    Stats stats;
+    stats.numPools = static_cast<uint32_t>(_pools.size());
+    for (auto& pool : _pools)
+    {
+        stats.numAllocatedSets += pool.numAllocatedSets;
+        stats.numFreeSets += pool.maxSets - pool.numAllocatedSets;
+    }
+    return stats;
+}
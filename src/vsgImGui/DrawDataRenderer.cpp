@@ -0,0 +1,1027 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/DrawDataRenderer.h>
+
+#include <vsg/core/Value.h>
+#include <vsg/io/Logger.h>
+#include <vsg/maths/transform.h>
+#include <vsg/state/ColorBlendState.h>
+#include <vsg/state/DepthStencilState.h>
+#include <vsg/state/DynamicState.h>
+#include <vsg/state/InputAssemblyState.h>
+#include <vsg/state/MultisampleState.h>
+#include <vsg/state/RasterizationState.h>
+#include <vsg/state/VertexInputState.h>
+#include <vsg/state/ViewportState.h>
+
+#include <cstring>
+#include <string>
+
+using namespace vsgImGui;
+
+namespace
+{
+    // each shader is embedded as SPIR-V so vsgImGui doesn't depend on VSG being built with glslang,
+    // the GLSL is kept as the ShaderModule's source, for reference and for regenerating the SPIR-V when a shader is changed
+    const char* imgui_vert = R"(
+#version 450
+layout(push_constant) uniform PushConstants {
+    mat4 projection;
+    mat4 modelView;
+} pc;
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec2 inTexCoord;
+layout(location = 2) in vec4 inColor;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+void main()
+{
+    fragColor = inColor;
+    fragTexCoord = inTexCoord;
+    gl_Position = (pc.projection * pc.modelView) * vec4(inPosition, 0.0, 1.0);
+}
+)";
+
+    const uint32_t imgui_vert_spv[] = {
+        0x07230203, 0x00010000, 0x00000000, 0x00000028, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+        0x00000000, 0x00000001, 0x000b000f, 0x00000000, 0x0000001a, 0x6e69616d, 0x00000000, 0x00000012,
+        0x00000013, 0x00000014, 0x00000015, 0x00000016, 0x00000017, 0x00030047, 0x00000007, 0x00000002,
+        0x00040048, 0x00000007, 0x00000000, 0x00000005, 0x00050048, 0x00000007, 0x00000000, 0x00000023,
+        0x00000000, 0x00050048, 0x00000007, 0x00000000, 0x00000007, 0x00000010, 0x00040048, 0x00000007,
+        0x00000001, 0x00000005, 0x00050048, 0x00000007, 0x00000001, 0x00000023, 0x00000040, 0x00050048,
+        0x00000007, 0x00000001, 0x00000007, 0x00000010, 0x00040047, 0x00000012, 0x0000001e, 0x00000000,
+        0x00040047, 0x00000013, 0x0000001e, 0x00000001, 0x00040047, 0x00000014, 0x0000001e, 0x00000002,
+        0x00040047, 0x00000015, 0x0000001e, 0x00000000, 0x00040047, 0x00000016, 0x0000001e, 0x00000001,
+        0x00040047, 0x00000017, 0x0000000b, 0x00000000, 0x00020013, 0x00000001, 0x00030021, 0x00000002,
+        0x00000001, 0x00030016, 0x00000003, 0x00000020, 0x00040017, 0x00000004, 0x00000003, 0x00000002,
+        0x00040017, 0x00000005, 0x00000003, 0x00000004, 0x00040018, 0x00000006, 0x00000005, 0x00000004,
+        0x0004001e, 0x00000007, 0x00000006, 0x00000006, 0x00040020, 0x00000008, 0x00000009, 0x00000007,
+        0x0004003b, 0x00000008, 0x00000009, 0x00000009, 0x00040015, 0x0000000a, 0x00000020, 0x00000001,
+        0x0004002b, 0x0000000a, 0x0000000b, 0x00000000, 0x0004002b, 0x0000000a, 0x0000000c, 0x00000001,
+        0x00040020, 0x0000000d, 0x00000009, 0x00000006, 0x00040020, 0x0000000e, 0x00000001, 0x00000004,
+        0x00040020, 0x0000000f, 0x00000001, 0x00000005, 0x00040020, 0x00000010, 0x00000003, 0x00000005,
+        0x00040020, 0x00000011, 0x00000003, 0x00000004, 0x0004003b, 0x0000000e, 0x00000012, 0x00000001,
+        0x0004003b, 0x0000000e, 0x00000013, 0x00000001, 0x0004003b, 0x0000000f, 0x00000014, 0x00000001,
+        0x0004003b, 0x00000010, 0x00000015, 0x00000003, 0x0004003b, 0x00000011, 0x00000016, 0x00000003,
+        0x0004003b, 0x00000010, 0x00000017, 0x00000003, 0x0004002b, 0x00000003, 0x00000018, 0x00000000,
+        0x0004002b, 0x00000003, 0x00000019, 0x3f800000, 0x00050036, 0x00000001, 0x0000001a, 0x00000000,
+        0x00000002, 0x000200f8, 0x0000001b, 0x0004003d, 0x00000005, 0x0000001c, 0x00000014, 0x0003003e,
+        0x00000015, 0x0000001c, 0x0004003d, 0x00000004, 0x0000001d, 0x00000013, 0x0003003e, 0x00000016,
+        0x0000001d, 0x00050041, 0x0000000d, 0x0000001e, 0x00000009, 0x0000000b, 0x0004003d, 0x00000006,
+        0x0000001f, 0x0000001e, 0x00050041, 0x0000000d, 0x00000020, 0x00000009, 0x0000000c, 0x0004003d,
+        0x00000006, 0x00000021, 0x00000020, 0x00050092, 0x00000006, 0x00000022, 0x0000001f, 0x00000021,
+        0x0004003d, 0x00000004, 0x00000023, 0x00000012, 0x00050051, 0x00000003, 0x00000024, 0x00000023,
+        0x00000000, 0x00050051, 0x00000003, 0x00000025, 0x00000023, 0x00000001, 0x00070050, 0x00000005,
+        0x00000026, 0x00000024, 0x00000025, 0x00000018, 0x00000019, 0x00050091, 0x00000005, 0x00000027,
+        0x00000022, 0x00000026, 0x0003003e, 0x00000017, 0x00000027, 0x000100fd, 0x00010038};
+
+    // the array size is set by the MAX_TEXTURES specialization constant when the bindless path is set up
+    const char* imgui_bindless_frag = R"(
+#version 450
+layout(push_constant) uniform PushConstants {
+    layout(offset = 128) uint textureIndex;
+} pc;
+
+layout(constant_id = 0) const uint MAX_TEXTURES = 1;
+layout(set = 0, binding = 0) uniform sampler2D textures[MAX_TEXTURES];
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    outColor = fragColor * texture(textures[pc.textureIndex], fragTexCoord);
+}
+)";
+
+    const uint32_t imgui_bindless_frag_spv[] = {
+        0x07230203, 0x00010000, 0x00000000, 0x00000024, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+        0x00000000, 0x00000001, 0x0008000f, 0x00000004, 0x0000001a, 0x6e69616d, 0x00000000, 0x00000017,
+        0x00000018, 0x00000019, 0x00030010, 0x0000001a, 0x00000007, 0x00040047, 0x00000009, 0x00000001,
+        0x00000000, 0x00040047, 0x0000000c, 0x00000022, 0x00000000, 0x00040047, 0x0000000c, 0x00000021,
+        0x00000000, 0x00030047, 0x0000000d, 0x00000002, 0x00050048, 0x0000000d, 0x00000000, 0x00000023,
+        0x00000080, 0x00040047, 0x00000017, 0x0000001e, 0x00000000, 0x00040047, 0x00000018, 0x0000001e,
+        0x00000001, 0x00040047, 0x00000019, 0x0000001e, 0x00000000, 0x00020013, 0x00000001, 0x00030021,
+        0x00000002, 0x00000001, 0x00030016, 0x00000003, 0x00000020, 0x00040017, 0x00000004, 0x00000003,
+        0x00000002, 0x00040017, 0x00000005, 0x00000003, 0x00000004, 0x00090019, 0x00000006, 0x00000003,
+        0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x0003001b, 0x00000007,
+        0x00000006, 0x00040015, 0x00000008, 0x00000020, 0x00000000, 0x00040032, 0x00000008, 0x00000009,
+        0x00000001, 0x0004001c, 0x0000000a, 0x00000007, 0x00000009, 0x00040020, 0x0000000b, 0x00000000,
+        0x0000000a, 0x0004003b, 0x0000000b, 0x0000000c, 0x00000000, 0x0003001e, 0x0000000d, 0x00000008,
+        0x00040020, 0x0000000e, 0x00000009, 0x0000000d, 0x0004003b, 0x0000000e, 0x0000000f, 0x00000009,
+        0x00040015, 0x00000010, 0x00000020, 0x00000001, 0x0004002b, 0x00000010, 0x00000011, 0x00000000,
+        0x00040020, 0x00000012, 0x00000009, 0x00000008, 0x00040020, 0x00000013, 0x00000000, 0x00000007,
+        0x00040020, 0x00000014, 0x00000001, 0x00000005, 0x00040020, 0x00000015, 0x00000001, 0x00000004,
+        0x00040020, 0x00000016, 0x00000003, 0x00000005, 0x0004003b, 0x00000014, 0x00000017, 0x00000001,
+        0x0004003b, 0x00000015, 0x00000018, 0x00000001, 0x0004003b, 0x00000016, 0x00000019, 0x00000003,
+        0x00050036, 0x00000001, 0x0000001a, 0x00000000, 0x00000002, 0x000200f8, 0x0000001b, 0x0004003d,
+        0x00000005, 0x0000001c, 0x00000017, 0x00050041, 0x00000012, 0x0000001d, 0x0000000f, 0x00000011,
+        0x0004003d, 0x00000008, 0x0000001e, 0x0000001d, 0x00050041, 0x00000013, 0x0000001f, 0x0000000c,
+        0x0000001e, 0x0004003d, 0x00000007, 0x00000020, 0x0000001f, 0x0004003d, 0x00000004, 0x00000021,
+        0x00000018, 0x00050057, 0x00000005, 0x00000022, 0x00000020, 0x00000021, 0x00050085, 0x00000005,
+        0x00000023, 0x0000001c, 0x00000022, 0x0003003e, 0x00000019, 0x00000023, 0x000100fd, 0x00010038};
+
+    const char* imgui_frag = R"(
+#version 450
+layout(set = 0, binding = 0) uniform sampler2D texSampler;
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    outColor = fragColor * texture(texSampler, fragTexCoord);
+}
+)";
+
+    const uint32_t imgui_frag_spv[] = {
+        0x07230203, 0x00010000, 0x00000000, 0x00000017, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+        0x00000000, 0x00000001, 0x0008000f, 0x00000004, 0x00000010, 0x6e69616d, 0x00000000, 0x0000000d,
+        0x0000000e, 0x0000000f, 0x00030010, 0x00000010, 0x00000007, 0x00040047, 0x00000009, 0x00000022,
+        0x00000000, 0x00040047, 0x00000009, 0x00000021, 0x00000000, 0x00040047, 0x0000000d, 0x0000001e,
+        0x00000000, 0x00040047, 0x0000000e, 0x0000001e, 0x00000001, 0x00040047, 0x0000000f, 0x0000001e,
+        0x00000000, 0x00020013, 0x00000001, 0x00030021, 0x00000002, 0x00000001, 0x00030016, 0x00000003,
+        0x00000020, 0x00040017, 0x00000004, 0x00000003, 0x00000002, 0x00040017, 0x00000005, 0x00000003,
+        0x00000004, 0x00090019, 0x00000006, 0x00000003, 0x00000001, 0x00000000, 0x00000000, 0x00000000,
+        0x00000001, 0x00000000, 0x0003001b, 0x00000007, 0x00000006, 0x00040020, 0x00000008, 0x00000000,
+        0x00000007, 0x0004003b, 0x00000008, 0x00000009, 0x00000000, 0x00040020, 0x0000000a, 0x00000001,
+        0x00000005, 0x00040020, 0x0000000b, 0x00000001, 0x00000004, 0x00040020, 0x0000000c, 0x00000003,
+        0x00000005, 0x0004003b, 0x0000000a, 0x0000000d, 0x00000001, 0x0004003b, 0x0000000b, 0x0000000e,
+        0x00000001, 0x0004003b, 0x0000000c, 0x0000000f, 0x00000003, 0x00050036, 0x00000001, 0x00000010,
+        0x00000000, 0x00000002, 0x000200f8, 0x00000011, 0x0004003d, 0x00000005, 0x00000012, 0x0000000d,
+        0x0004003d, 0x00000007, 0x00000013, 0x00000009, 0x0004003d, 0x00000004, 0x00000014, 0x0000000e,
+        0x00050057, 0x00000005, 0x00000015, 0x00000013, 0x00000014, 0x00050085, 0x00000005, 0x00000016,
+        0x00000012, 0x00000015, 0x0003003e, 0x0000000f, 0x00000016, 0x000100fd, 0x00010038};
+
+    template<size_t N>
+    vsg::ref_ptr<vsg::ShaderStage> createShaderStage(VkShaderStageFlagBits stage, const char* source, const uint32_t (&code)[N])
+    {
+        auto shaderModule = vsg::ShaderModule::create(std::string(source), vsg::ShaderModule::SPIRV(code, code + N));
+        return vsg::ShaderStage::create(stage, "main", shaderModule);
+    }
+
+    VkDeviceSize alignedSize(VkDeviceSize size, VkDeviceSize alignment)
+    {
+        return ((size + alignment - 1) / alignment) * alignment;
+    }
+
+    inline uint64_t hash_combine(uint64_t seed, uint64_t value)
+    {
+        seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+
+    inline uint64_t hash_float(uint64_t seed, float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return hash_combine(seed, bits);
+    }
+
+    // hash size bytes a word at a time, reading from system memory is several times quicker than writing the same data to write-combined buffer memory
+    inline uint64_t hash_bytes(uint64_t seed, const void* data, size_t size)
+    {
+        auto ptr = static_cast<const uint8_t*>(data);
+        auto end = ptr + (size & ~size_t(7));
+        for (; ptr != end; ptr += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, ptr, sizeof(word));
+            seed = (seed ^ (word * 0xff51afd7ed558ccdull)) * 0x100000001b3ull;
+        }
+
+        uint64_t tail = 0;
+        if ((size & 7) != 0) std::memcpy(&tail, ptr, size & 7);
+        return hash_combine(seed, tail ^ size);
+    }
+} // namespace
+
+DrawDataRenderer::DrawDataRenderer(vsg::Context& context, uint32_t numFrames) :
+    device(context.device),
+    _frames(std::max(numFrames, 1u)),
+    _queueFamily(context.graphicsQueue ? context.graphicsQueue->queueFamilyIndex() : 0)
+{
+    // vertex and index buffers are written every frame so keep them in their own host visible pools rather than sharing the scene graph's.
+    memoryBufferPools = vsg::MemoryBufferPools::create("vsgImGui_MemoryBufferPools", device);
+
+    vsg::DescriptorSetLayoutBindings descriptorBindings{
+        {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr} // { binding, descriptorType, descriptorCount, stageFlags, pImmutableSamplers }
+    };
+    descriptorSetLayout = vsg::DescriptorSetLayout::create(descriptorBindings);
+
+    // use the same projection/modelView push constant layout as the rest of the VSG so the State's matrix stacks can be used, vsg::State pushes the matrices
+    // with the first range's stage flags so the ranges mustn't overlap. The fragment range holds the bindless texture index and is shared by both pipelines
+    // so switching between them leaves the push constants intact
+    vsg::PushConstantRanges pushConstantRanges{
+        {VK_SHADER_STAGE_VERTEX_BIT, 0, 128},  // projection, view, and model matrices, actual push constant calls automatically provided by the VSG's RecordTraversal
+        {VK_SHADER_STAGE_FRAGMENT_BIT, 128, 4} // bindless texture index
+    };
+    pipelineLayout = vsg::PipelineLayout::create(vsg::DescriptorSetLayouts{descriptorSetLayout}, pushConstantRanges);
+
+    vsg::ShaderStages shaderStages{
+        createShaderStage(VK_SHADER_STAGE_VERTEX_BIT, imgui_vert, imgui_vert_spv),
+        createShaderStage(VK_SHADER_STAGE_FRAGMENT_BIT, imgui_frag, imgui_frag_spv)};
+
+    vsg::VertexInputState::Bindings vertexBindingsDescriptions{
+        VkVertexInputBindingDescription{0, sizeof(ImDrawVert), VK_VERTEX_INPUT_RATE_VERTEX}};
+
+    vsg::VertexInputState::Attributes vertexAttributeDescriptions{
+        VkVertexInputAttributeDescription{0, 0, VK_FORMAT_R32G32_SFLOAT, static_cast<uint32_t>(offsetof(ImDrawVert, pos))},
+        VkVertexInputAttributeDescription{1, 0, VK_FORMAT_R32G32_SFLOAT, static_cast<uint32_t>(offsetof(ImDrawVert, uv))},
+        VkVertexInputAttributeDescription{2, 0, VK_FORMAT_R8G8B8A8_UNORM, static_cast<uint32_t>(offsetof(ImDrawVert, col))}};
+
+    auto rasterizationState = vsg::RasterizationState::create();
+    rasterizationState->cullMode = VK_CULL_MODE_NONE;
+
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+    if (context.renderPass)
+    {
+        for (auto& attachment : context.renderPass->attachments)
+        {
+            if (attachment.samples > samples) samples = attachment.samples;
+        }
+    }
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
+    colorBlendAttachment.blendEnable = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    auto colorBlendState = vsg::ColorBlendState::create();
+    colorBlendState->attachments = vsg::ColorBlendState::ColorBlendAttachments{colorBlendAttachment};
+
+    auto depthStencilState = vsg::DepthStencilState::create();
+    depthStencilState->depthTestEnable = VK_FALSE;
+    depthStencilState->depthWriteEnable = VK_FALSE;
+
+    // viewport and scissor are set per frame/ImDrawCmd so the pipeline is independent of the window size
+    auto dynamicState = vsg::DynamicState::create();
+    dynamicState->dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    vsg::GraphicsPipelineStates pipelineStates{
+        vsg::VertexInputState::create(vertexBindingsDescriptions, vertexAttributeDescriptions),
+        vsg::InputAssemblyState::create(),
+        rasterizationState,
+        vsg::MultisampleState::create(samples),
+        colorBlendState,
+        depthStencilState,
+        vsg::ViewportState::create(0, 0, 1, 1),
+        dynamicState};
+
+    auto graphicsPipeline = vsg::GraphicsPipeline::create(pipelineLayout, shaderStages, pipelineStates);
+    bindGraphicsPipeline = BindCachedGraphicsPipeline::create(graphicsPipeline);
+
+    _updateBufferStats();
+}
+
+void DrawDataRenderer::setupBindlessTextures(uint32_t maxTextures)
+{
+    if (_bindless.maxTextures > 0 || maxTextures == 0) return;
+
+    _bindless.maxTextures = maxTextures;
+
+    vsg::DescriptorSetLayoutBindings descriptorBindings{
+        {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, maxTextures, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr}};
+    bindlessDescriptorSetLayout = vsg::DescriptorSetLayout::create(descriptorBindings);
+    bindlessPipelineLayout = vsg::PipelineLayout::create(vsg::DescriptorSetLayouts{bindlessDescriptorSetLayout}, pipelineLayout->pushConstantRanges);
+
+    auto fragmentShader = createShaderStage(VK_SHADER_STAGE_FRAGMENT_BIT, imgui_bindless_frag, imgui_bindless_frag_spv);
+    fragmentShader->specializationConstants = vsg::ShaderStage::SpecializationConstants{{0, vsg::uintValue::create(maxTextures)}};
+
+    auto& graphicsPipeline = bindGraphicsPipeline->pipeline;
+    vsg::ShaderStages shaderStages{graphicsPipeline->stages[0], fragmentShader};
+
+    auto bindlessPipeline = vsg::GraphicsPipeline::create(bindlessPipelineLayout, shaderStages, graphicsPipeline->pipelineStates);
+    bindlessPipeline->subpass = graphicsPipeline->subpass;
+    bindBindlessGraphicsPipeline = BindCachedGraphicsPipeline::create(bindlessPipeline, bindGraphicsPipeline->pipelineCache);
+}
+
+bool DrawDataRenderer::addBindlessTexture(ImTextureID id, vsg::ref_ptr<vsg::ImageInfo> imageInfo)
+{
+    if (_bindless.images.size() >= _bindless.maxTextures || _bindless.indices.count(id) != 0) return false;
+    if (!imageInfo || !imageInfo->sampler || !imageInfo->imageView || imageInfo->imageView->vk(device->deviceID) == VK_NULL_HANDLE) return false;
+
+    _bindless.indices[id] = static_cast<uint32_t>(_bindless.images.size());
+    _bindless.images.push_back(imageInfo);
+    ++_bindless.version;
+    return true;
+}
+
+void DrawDataRenderer::compile(vsg::Context& context)
+{
+    descriptorSetLayout->compile(context);
+    bindGraphicsPipeline->compile(context);
+
+    if (_bindless.maxTextures > 0 && _bindless.descriptorPool == VK_NULL_HANDLE)
+    {
+        // the pipeline cache may have been assigned after setupBindlessTextures(..)
+        bindBindlessGraphicsPipeline->pipelineCache = bindGraphicsPipeline->pipelineCache;
+
+        bindlessDescriptorSetLayout->compile(context);
+        bindBindlessGraphicsPipeline->compile(context);
+
+        auto numFrames = static_cast<uint32_t>(_frames.size());
+        VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, _bindless.maxTextures * numFrames};
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = numFrames;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        if (vkCreateDescriptorPool(*device, &poolInfo, device->getAllocationCallbacks(), &_bindless.descriptorPool) != VK_SUCCESS)
+        {
+            vsg::warn("vsgImGui::DrawDataRenderer unable to create the bindless descriptor pool, falling back to binding textures individually.");
+            _bindless.descriptorPool = VK_NULL_HANDLE;
+            return;
+        }
+
+        VkDescriptorSetLayout layout = bindlessDescriptorSetLayout->vk(device->deviceID);
+        for (auto& frame : _frames)
+        {
+            VkDescriptorSetAllocateInfo allocateInfo{};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocateInfo.descriptorPool = _bindless.descriptorPool;
+            allocateInfo.descriptorSetCount = 1;
+            allocateInfo.pSetLayouts = &layout;
+            if (vkAllocateDescriptorSets(*device, &allocateInfo, &frame.bindlessDescriptorSet) != VK_SUCCESS) frame.bindlessDescriptorSet = VK_NULL_HANDLE;
+        }
+    }
+}
+
+void DrawDataRenderer::setupTimestamps(uint32_t windowSize, const vsg::DeviceFeatures* deviceFeatures)
+{
+    if (_timestamps.queryPool || windowSize == 0) return;
+
+    auto& limits = device->getPhysicalDevice()->getProperties().limits;
+    if (!limits.timestampComputeAndGraphics)
+    {
+        vsg::warn("vsgImGui::DrawDataRenderer device doesn't support timestamps on graphics queues, GPU timing disabled.");
+        return;
+    }
+
+    auto& queueFamilyProperties = device->getPhysicalDevice()->getQueueFamilyProperties();
+    uint32_t timestampValidBits = (_queueFamily < queueFamilyProperties.size()) ? queueFamilyProperties[_queueFamily].timestampValidBits : 0;
+    if (timestampValidBits == 0)
+    {
+        vsg::warn("vsgImGui::DrawDataRenderer queue family ", _queueFamily, " doesn't support timestamps, GPU timing disabled.");
+        return;
+    }
+
+    // the function pointer may be available without the feature having been enabled, so check the features the device was created with
+    bool hostQueryReset = false;
+    for (auto feature = static_cast<const VkBaseInStructure*>(deviceFeatures ? deviceFeatures->data() : nullptr); feature && !hostQueryReset; feature = feature->pNext)
+    {
+        if (feature->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES)
+            hostQueryReset = reinterpret_cast<const VkPhysicalDeviceHostQueryResetFeatures*>(feature)->hostQueryReset == VK_TRUE;
+        else if (feature->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES)
+            hostQueryReset = reinterpret_cast<const VkPhysicalDeviceVulkan12Features*>(feature)->hostQueryReset == VK_TRUE;
+    }
+    if (!hostQueryReset)
+    {
+        vsg::warn("vsgImGui::DrawDataRenderer hostQueryReset feature not enabled on the device, GPU timing disabled.");
+        return;
+    }
+
+    // set up the queries in a local Timestamps, then replace _timestamps under the lock as getTimingStats() may be reading it from another thread
+    Timestamps timestamps;
+
+    // Vulkan 1.2 core, or the VK_EXT_host_query_reset extension
+    timestamps.vkResetQueryPool = reinterpret_cast<PFN_vkResetQueryPool>(vkGetDeviceProcAddr(*device, "vkResetQueryPool"));
+    if (!timestamps.vkResetQueryPool) timestamps.vkResetQueryPool = reinterpret_cast<PFN_vkResetQueryPool>(vkGetDeviceProcAddr(*device, "vkResetQueryPoolEXT"));
+    if (!timestamps.vkResetQueryPool)
+    {
+        vsg::warn("vsgImGui::DrawDataRenderer vkResetQueryPool not available, GPU timing disabled.");
+        return;
+    }
+
+    // allow for the UI being recorded more than once per frame
+    timestamps.slots.resize(_frames.size() * 2);
+
+    VkQueryPoolCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    createInfo.queryCount = static_cast<uint32_t>(timestamps.slots.size() * 2);
+    if (vkCreateQueryPool(*device, &createInfo, device->getAllocationCallbacks(), &timestamps.queryPool) != VK_SUCCESS)
+    {
+        vsg::warn("vsgImGui::DrawDataRenderer unable to create timestamp query pool, GPU timing disabled.");
+        return;
+    }
+
+    // queries must be reset before their first use
+    timestamps.vkResetQueryPool(*device, timestamps.queryPool, 0, createInfo.queryCount);
+
+    timestamps.timestampPeriod = limits.timestampPeriod;
+    timestamps.timestampMask = (timestampValidBits >= 64) ? ~0ull : ((1ull << timestampValidBits) - 1);
+    timestamps.window.resize(windowSize);
+
+    std::scoped_lock<std::mutex> lock(_timestampsMutex);
+    _timestamps = std::move(timestamps);
+}
+
+DrawDataRenderer::TimingStats DrawDataRenderer::getTimingStats() const
+{
+    std::scoped_lock<std::mutex> lock(_timestampsMutex);
+
+    TimingStats stats;
+    stats.numFrames = static_cast<uint32_t>(_timestamps.numSamples);
+    if (_timestamps.numSamples == 0) return stats;
+
+    auto accumulate = [](Range& range, double value, bool first) {
+        range.min = first ? value : std::min(range.min, value);
+        range.max = first ? value : std::max(range.max, value);
+        range.average += value;
+    };
+
+    for (size_t i = 0; i < _timestamps.numSamples; ++i)
+    {
+        auto& sample = _timestamps.window[i];
+        bool first = (i == 0);
+        accumulate(stats.gpuTime, sample.gpuTime, first);
+        accumulate(stats.drawCalls, sample.drawCalls, first);
+        accumulate(stats.vertices, sample.vertices, first);
+        accumulate(stats.indices, sample.indices, first);
+        accumulate(stats.descriptorSetBinds, sample.descriptorSetBinds, first);
+    }
+
+    double scale = 1.0 / static_cast<double>(_timestamps.numSamples);
+    for (auto range : {&stats.gpuTime, &stats.drawCalls, &stats.vertices, &stats.indices, &stats.descriptorSetBinds}) range->average *= scale;
+
+    return stats;
+}
+
+DrawDataRenderer::TimestampSlot* DrawDataRenderer::_writeStartTimestamp(vsg::CommandBuffer& commandBuffer, uint64_t frameCount)
+{
+    auto& slot = _timestamps.slots[_timestamps.slotIndex];
+    uint32_t firstQuery = static_cast<uint32_t>(_timestamps.slotIndex * 2);
+
+    if (slot.pending)
+    {
+        // never wait on the GPU, if the slot's previous frame hasn't completed this frame simply isn't timed
+        uint64_t results[2];
+        VkResult result = vkGetQueryPoolResults(*device, _timestamps.queryPool, firstQuery, 2, sizeof(results), results, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+        if (result == VK_NOT_READY)
+        {
+            // the queries may still be written by a command buffer in flight, which makes resetting them from the host undefined, so skip the slot.
+            // Once numFrames frames have passed its command buffer has completed, so results that still aren't available were never written,
+            // e.g. the command buffer wasn't submitted after a resize, and the slot can be reset and reused
+            bool completed = frameCount >= slot.frameCount + _frames.size();
+            if (!completed)
+            {
+                _timestamps.slotIndex = (_timestamps.slotIndex + 1) % _timestamps.slots.size();
+                return nullptr;
+            }
+            vsg::debug("vsgImGui::DrawDataRenderer timestamp queries ", firstQuery, " never written, discarding them.");
+        }
+        else if (result == VK_SUCCESS)
+        {
+            // only timestampValidBits are written, masking the difference handles the counter wrapping round between the queries
+            uint64_t ticks = (results[1] - results[0]) & _timestamps.timestampMask;
+            slot.sample.gpuTime = static_cast<double>(ticks) * _timestamps.timestampPeriod * 1e-6;
+
+            std::scoped_lock<std::mutex> lock(_timestampsMutex);
+            _timestamps.window[_timestamps.windowIndex] = slot.sample;
+            _timestamps.windowIndex = (_timestamps.windowIndex + 1) % _timestamps.window.size();
+            _timestamps.numSamples = std::min(_timestamps.numSamples + 1, _timestamps.window.size());
+        }
+        slot.pending = false;
+
+        _timestamps.vkResetQueryPool(*device, _timestamps.queryPool, firstQuery, 2);
+    }
+
+    slot.frameCount = frameCount;
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _timestamps.queryPool, firstQuery);
+    _timestamps.slotIndex = (_timestamps.slotIndex + 1) % _timestamps.slots.size();
+    return &slot;
+}
+
+DrawDataRenderer::~DrawDataRenderer()
+{
+    if (_timestamps.queryPool) vkDestroyQueryPool(*device, _timestamps.queryPool, device->getAllocationCallbacks());
+
+    // destroying the pool frees the bindless descriptor sets
+    if (_bindless.descriptorPool) vkDestroyDescriptorPool(*device, _bindless.descriptorPool, device->getAllocationCallbacks());
+
+    for (auto& frame : _frames)
+    {
+        _release(frame.vertices);
+        _release(frame.indices);
+    }
+}
+
+bool DrawDataRenderer::_allocate(MappedBuffer& mappedBuffer, VkDeviceSize size, VkBufferUsageFlags usage)
+{
+    size = alignedSize(size, 256);
+
+    auto bufferInfo = memoryBufferPools->reserveBuffer(size, 4, usage, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (!bufferInfo) return false;
+
+    auto deviceID = device->deviceID;
+    auto memory = bufferInfo->buffer->getDeviceMemory(deviceID);
+
+    auto& mappedMemory = _mappedMemory[memory];
+    if (!mappedMemory.data)
+    {
+        if (memory->map(0, VK_WHOLE_SIZE, 0, &mappedMemory.data) != VK_SUCCESS)
+        {
+            _mappedMemory.erase(memory);
+            bufferInfo->release();
+            return false;
+        }
+        mappedMemory.memory = memory;
+    }
+    ++mappedMemory.referenceCount;
+
+    mappedBuffer.bufferInfo = bufferInfo;
+    mappedBuffer.data = static_cast<uint8_t*>(mappedMemory.data) + bufferInfo->buffer->getMemoryOffset(deviceID) + bufferInfo->offset;
+    mappedBuffer.capacity = size;
+    mappedBuffer.lowUsageCount = 0;
+    return true;
+}
+
+void DrawDataRenderer::_release(MappedBuffer& mappedBuffer)
+{
+    if (!mappedBuffer.bufferInfo) return;
+
+    auto memory = mappedBuffer.bufferInfo->buffer->getDeviceMemory(device->deviceID);
+    if (auto itr = _mappedMemory.find(memory); itr != _mappedMemory.end() && --(itr->second.referenceCount) == 0)
+    {
+        itr->second.memory->unmap();
+        _mappedMemory.erase(itr);
+    }
+
+    mappedBuffer.bufferInfo->release();
+    mappedBuffer = {};
+}
+
+bool DrawDataRenderer::_resize(MappedBuffer& mappedBuffer, VkDeviceSize requiredSize, VkDeviceSize minimumSize, VkBufferUsageFlags usage)
+{
+    if (mappedBuffer.capacity < requiredSize)
+    {
+        // grow geometrically so that steadily growing UIs settle after a few reallocations
+        VkDeviceSize newSize = std::max(static_cast<VkDeviceSize>(static_cast<double>(requiredSize) * growthFactor), minimumSize);
+
+        vsg::debug("vsgImGui::DrawDataRenderer growing buffer from ", mappedBuffer.capacity, " to ", newSize, " bytes.");
+
+        _release(mappedBuffer);
+        ++_bufferStats.numGrows;
+        return _allocate(mappedBuffer, newSize, usage);
+    }
+
+    // only shrink after sustained low usage to avoid thrashing as windows are opened and closed
+    VkDeviceSize shrunkSize = std::max(static_cast<VkDeviceSize>(static_cast<double>(requiredSize) * growthFactor), minimumSize);
+    if (static_cast<double>(requiredSize) < static_cast<double>(mappedBuffer.capacity) * shrinkThreshold && shrunkSize < mappedBuffer.capacity)
+    {
+        if (++mappedBuffer.lowUsageCount >= shrinkDelay)
+        {
+            vsg::debug("vsgImGui::DrawDataRenderer shrinking buffer from ", mappedBuffer.capacity, " to ", shrunkSize, " bytes.");
+
+            _release(mappedBuffer);
+            ++_bufferStats.numShrinks;
+            return _allocate(mappedBuffer, shrunkSize, usage);
+        }
+    }
+    else
+    {
+        mappedBuffer.lowUsageCount = 0;
+    }
+
+    return mappedBuffer.data != nullptr;
+}
+
+void DrawDataRenderer::_updateBufferStats()
+{
+    _bufferStats.numFrames = static_cast<uint32_t>(_frames.size());
+    _bufferStats.vertexBufferSize = 0;
+    _bufferStats.indexBufferSize = 0;
+    for (auto& frame : _frames)
+    {
+        _bufferStats.vertexBufferSize = std::max(_bufferStats.vertexBufferSize, frame.vertices.capacity);
+        _bufferStats.indexBufferSize = std::max(_bufferStats.indexBufferSize, frame.indices.capacity);
+    }
+}
+
+void DrawDataRenderer::reserve(VkDeviceSize vertexBufferSize, VkDeviceSize indexBufferSize)
+{
+    _retainedFrame = nullptr;
+
+    for (auto& frame : _frames)
+    {
+        if (frame.vertices.capacity < vertexBufferSize)
+        {
+            _release(frame.vertices);
+            _allocate(frame.vertices, vertexBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        }
+        if (frame.indices.capacity < indexBufferSize)
+        {
+            _release(frame.indices);
+            _allocate(frame.indices, indexBufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+        }
+    }
+    _updateBufferStats();
+}
+
+void DrawDataRenderer::copySettings(const DrawDataRenderer& rhs)
+{
+    growthFactor = rhs.growthFactor;
+    shrinkThreshold = rhs.shrinkThreshold;
+    shrinkDelay = rhs.shrinkDelay;
+    minimumVertexBufferSize = rhs.minimumVertexBufferSize;
+    minimumIndexBufferSize = rhs.minimumIndexBufferSize;
+    retainUnchangedFrames = rhs.retainUnchangedFrames;
+    mergeDrawCommands = rhs.mergeDrawCommands;
+}
+
+uint64_t DrawDataRenderer::fingerprint(const ImDrawData* drawData)
+{
+    uint64_t seed = hash_combine(0, static_cast<uint64_t>(drawData->CmdListsCount));
+    seed = hash_combine(seed, static_cast<uint64_t>(drawData->TotalVtxCount));
+    seed = hash_combine(seed, static_cast<uint64_t>(drawData->TotalIdxCount));
+
+    for (int n = 0; n < drawData->CmdListsCount; ++n)
+    {
+        const ImDrawList* cmd_list = drawData->CmdLists[n];
+        seed = hash_combine(seed, static_cast<uint64_t>(cmd_list->CmdBuffer.Size));
+        for (const auto& cmd : cmd_list->CmdBuffer)
+        {
+            seed = hash_float(seed, cmd.ClipRect.x);
+            seed = hash_float(seed, cmd.ClipRect.y);
+            seed = hash_float(seed, cmd.ClipRect.z);
+            seed = hash_float(seed, cmd.ClipRect.w);
+            seed = hash_combine(seed, reinterpret_cast<uint64_t>(cmd.GetTexID()));
+            seed = hash_combine(seed, reinterpret_cast<uint64_t>(cmd.UserCallback));
+            seed = hash_combine(seed, (static_cast<uint64_t>(cmd.VtxOffset) << 32) | cmd.IdxOffset);
+            seed = hash_combine(seed, cmd.ElemCount);
+        }
+
+        seed = hash_bytes(seed, cmd_list->VtxBuffer.Data, static_cast<size_t>(cmd_list->VtxBuffer.Size) * sizeof(ImDrawVert));
+        seed = hash_bytes(seed, cmd_list->IdxBuffer.Data, static_cast<size_t>(cmd_list->IdxBuffer.Size) * sizeof(ImDrawIdx));
+    }
+    return seed;
+}
+
+void DrawDataRenderer::_upload(FrameBuffers& frame, const ImDrawData* drawData)
+{
+    VkDeviceSize vertexSize = static_cast<VkDeviceSize>(drawData->TotalVtxCount) * sizeof(ImDrawVert);
+    VkDeviceSize indexSize = static_cast<VkDeviceSize>(drawData->TotalIdxCount) * sizeof(ImDrawIdx);
+
+    _bufferStats.peakVertexDataSize = std::max(_bufferStats.peakVertexDataSize, vertexSize);
+    _bufferStats.peakIndexDataSize = std::max(_bufferStats.peakIndexDataSize, indexSize);
+
+    auto previousGrows = _bufferStats.numGrows;
+    auto previousShrinks = _bufferStats.numShrinks;
+
+    bool vertexResult = _resize(frame.vertices, vertexSize, minimumVertexBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    bool indexResult = _resize(frame.indices, indexSize, minimumIndexBufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+
+    if (_bufferStats.numGrows != previousGrows || _bufferStats.numShrinks != previousShrinks) _updateBufferStats();
+
+    if (!vertexResult || !indexResult)
+    {
+        vsg::warn("vsgImGui::DrawDataRenderer unable to allocate vertex/index buffers.");
+        return;
+    }
+
+    auto vertexDestination = static_cast<ImDrawVert*>(frame.vertices.data);
+    auto indexDestination = static_cast<ImDrawIdx*>(frame.indices.data);
+    for (int n = 0; n < drawData->CmdListsCount; ++n)
+    {
+        const ImDrawList* cmd_list = drawData->CmdLists[n];
+        if (cmd_list->VtxBuffer.Size > 0) std::memcpy(vertexDestination, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        if (cmd_list->IdxBuffer.Size > 0) std::memcpy(indexDestination, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        vertexDestination += cmd_list->VtxBuffer.Size;
+        indexDestination += cmd_list->IdxBuffer.Size;
+    }
+}
+
+void DrawDataRenderer::_setupRenderState(vsg::CommandBuffer& commandBuffer, const FrameBuffers& frame, int fb_width, int fb_height)
+{
+    auto deviceID = commandBuffer.deviceID;
+
+    auto& vertices = frame.vertices.bufferInfo;
+    auto& indices = frame.indices.bufferInfo;
+
+    VkBuffer vertexBuffers[] = {vertices->buffer->vk(deviceID)};
+    VkDeviceSize vertexOffsets[] = {vertices->offset};
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, vertexOffsets);
+    vkCmdBindIndexBuffer(commandBuffer, indices->buffer->vk(deviceID), indices->offset, indexType);
+
+    VkViewport viewport{0.0f, 0.0f, static_cast<float>(fb_width), static_cast<float>(fb_height), 0.0f, 1.0f};
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+}
+
+void DrawDataRenderer::_updateBindlessDescriptorSet(FrameBuffers& frame)
+{
+    auto deviceID = device->deviceID;
+
+    // every element of the array must be valid when the set is bound, so unused elements refer to the first image
+    std::vector<VkDescriptorImageInfo> imageInfos(_bindless.maxTextures);
+    for (uint32_t i = 0; i < _bindless.maxTextures; ++i)
+    {
+        auto& imageInfo = (i < _bindless.images.size()) ? _bindless.images[i] : _bindless.images.front();
+        imageInfos[i] = VkDescriptorImageInfo{imageInfo->sampler->vk(deviceID), imageInfo->imageView->vk(deviceID), imageInfo->imageLayout};
+    }
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = frame.bindlessDescriptorSet;
+    write.dstBinding = 0;
+    write.dstArrayElement = 0;
+    write.descriptorCount = _bindless.maxTextures;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = imageInfos.data();
+    vkUpdateDescriptorSets(*device, 1, &write, 0, nullptr);
+
+    frame.bindlessVersion = _bindless.version;
+}
+
+void DrawDataRenderer::record(vsg::State& state, const ImDrawData* drawData, bool unchanged, uint64_t frameCount)
+{
+    // avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
+    int fb_width = static_cast<int>(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+    int fb_height = static_cast<int>(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0 || drawData->TotalVtxCount <= 0) return;
+
+    auto& commandBuffer = *(state._commandBuffer);
+    auto deviceID = commandBuffer.deviceID;
+
+    // nothing can be drawn if the pipeline failed to compile
+    if (bindGraphicsPipeline->vk(deviceID) == VK_NULL_HANDLE) return;
+
+    FrameBuffers* retainedFrame = nullptr;
+    if (unchanged)
+    {
+        retainedFrame = _retainedFrame;
+    }
+    else if (retainUnchangedFrames)
+    {
+        uint64_t frameFingerprint = fingerprint(drawData);
+        if (_retainedFrame && frameFingerprint == _retainedFingerprint) retainedFrame = _retainedFrame;
+        _retainedFingerprint = frameFingerprint;
+    }
+
+    // the bindless descriptor set of a frame that may be in flight can't be updated, so newly registered textures need a fresh frame
+    if (retainedFrame && retainedFrame->bindlessDescriptorSet && retainedFrame->bindlessVersion != _bindless.version) retainedFrame = nullptr;
+
+    if (retainedFrame)
+    {
+        // the previously uploaded frame isn't written to until the data changes, so it's safe to reuse while later frames are in flight.
+        std::scoped_lock<std::mutex> lock(_recordStatsMutex);
+        ++_recordStats.numRetainedFrames;
+    }
+    else
+    {
+        retainedFrame = &_frames[_frameIndex];
+        _frameIndex = (_frameIndex + 1) % _frames.size();
+
+        _upload(*retainedFrame, drawData);
+        {
+            std::scoped_lock<std::mutex> lock(_recordStatsMutex);
+            ++_recordStats.numUploadedFrames;
+        }
+
+        if (retainedFrame->bindlessDescriptorSet && !_bindless.images.empty() && retainedFrame->bindlessVersion != _bindless.version)
+        {
+            _updateBindlessDescriptorSet(*retainedFrame);
+        }
+
+        _retainedFrame = (retainedFrame->vertices.data && retainedFrame->indices.data) ? retainedFrame : nullptr;
+    }
+
+    auto& frame = *retainedFrame;
+    if (!frame.vertices.data || !frame.indices.data) return;
+
+    // map ImGui's display coordinates to Vulkan's clip space, both have the y axis pointing down.
+    const ImVec2& displayPos = drawData->DisplayPos;
+    const ImVec2& displaySize = drawData->DisplaySize;
+    auto projection = vsg::translate(-1.0 - 2.0 * displayPos.x / displaySize.x, -1.0 - 2.0 * displayPos.y / displaySize.y, 0.0) *
+                      vsg::scale(2.0 / displaySize.x, 2.0 / displaySize.y, 1.0);
+
+    TimestampSlot* timestampSlot = _timestamps.queryPool ? _writeStartTimestamp(commandBuffer, frameCount) : nullptr;
+
+    bool bindlessActive = frame.bindlessDescriptorSet && !_bindless.images.empty() && frame.bindlessVersion == _bindless.version &&
+                          bindBindlessGraphicsPipeline->vk(deviceID) != VK_NULL_HANDLE;
+    bool bindlessPipelineBound = bindlessActive;
+    bool bindlessDescriptorSetBound = false;
+    auto& pipeline = bindlessActive ? bindBindlessGraphicsPipeline : bindGraphicsPipeline;
+
+    // bind the pipeline and push the matrices via vsg::State so that the scene graph's state is restored once the UI has been recorded
+    state.push(pipeline);
+    state.projectionMatrixStack.push(projection);
+    state.modelviewMatrixStack.push(vsg::dmat4());
+    state.dirty = true;
+    state.record();
+
+    _setupRenderState(commandBuffer, frame, fb_width, fb_height);
+
+    VkPipelineLayout vk_pipelineLayout = pipelineLayout->vk(deviceID);
+    VkPipelineLayout vk_bindlessPipelineLayout = bindlessActive ? bindlessPipelineLayout->vk(deviceID) : VK_NULL_HANDLE;
+    VkDescriptorSet boundDescriptorSet = VK_NULL_HANDLE;
+    VkRect2D boundScissor{};
+    bool scissorBound = false;
+
+    // each draw is deferred until the next command is known, so when mergeDrawCommands is enabled commands that follow on can be appended to it
+    struct PendingDraw
+    {
+        uint32_t indexCount = 0;
+        uint32_t firstIndex = 0;
+        int32_t vertexOffset = 0;
+    } pending;
+
+    uint32_t numDrawCommands = 0;
+    uint32_t numDrawCalls = 0;
+    uint32_t numDescriptorSetBinds = 0;
+    auto flush = [&]() {
+        if (pending.indexCount == 0) return;
+        vkCmdDrawIndexed(commandBuffer, pending.indexCount, 1, pending.firstIndex, pending.vertexOffset, 0);
+        pending.indexCount = 0;
+        ++numDrawCalls;
+    };
+
+    // project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = drawData->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = drawData->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+    int global_vtx_offset = 0;
+    int global_idx_offset = 0;
+    for (int n = 0; n < drawData->CmdListsCount; ++n)
+    {
+        const ImDrawList* cmd_list = drawData->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; ++cmd_i)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != nullptr)
+            {
+                flush();
+
+                // user callback, registered via ImDrawList::AddCallback()
+                if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
+                    _setupRenderState(commandBuffer, frame, fb_width, fb_height);
+                }
+                else
+                {
+                    pcmd->UserCallback(cmd_list, pcmd);
+                }
+
+                // the callback may have changed the dynamic state
+                boundDescriptorSet = VK_NULL_HANDLE;
+                bindlessDescriptorSetBound = false;
+                scissorBound = false;
+                continue;
+            }
+
+            ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+            ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+
+            // clamp to viewport as vkCmdSetScissor() won't accept values that are off bounds
+            if (clip_min.x < 0.0f) clip_min.x = 0.0f;
+            if (clip_min.y < 0.0f) clip_min.y = 0.0f;
+            if (clip_max.x > fb_width) clip_max.x = static_cast<float>(fb_width);
+            if (clip_max.y > fb_height) clip_max.y = static_cast<float>(fb_height);
+            if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y) continue;
+
+            VkRect2D scissor;
+            scissor.offset.x = static_cast<int32_t>(clip_min.x);
+            scissor.offset.y = static_cast<int32_t>(clip_min.y);
+            scissor.extent.width = static_cast<uint32_t>(clip_max.x - clip_min.x);
+            scissor.extent.height = static_cast<uint32_t>(clip_max.y - clip_min.y);
+
+            VkDescriptorSet descriptorSet = pcmd->GetTexID();
+            if (!textureMap.empty())
+            {
+                if (auto itr = textureMap.find(descriptorSet); itr != textureMap.end()) descriptorSet = itr->second;
+            }
+            if (descriptorSet == VK_NULL_HANDLE) continue;
+
+            ++numDrawCommands;
+
+            uint32_t firstIndex = pcmd->IdxOffset + global_idx_offset;
+            int32_t vertexOffset = static_cast<int32_t>(pcmd->VtxOffset + global_vtx_offset);
+
+            bool sameScissor = scissorBound && scissor.offset.x == boundScissor.offset.x && scissor.offset.y == boundScissor.offset.y &&
+                               scissor.extent.width == boundScissor.extent.width && scissor.extent.height == boundScissor.extent.height;
+            bool sameDescriptorSet = (descriptorSet == boundDescriptorSet);
+
+            // the same texture, scissor and base vertex with indices directly following the pending draw's can be drawn with a single call
+            if (mergeDrawCommands && pending.indexCount > 0 && sameScissor && sameDescriptorSet &&
+                vertexOffset == pending.vertexOffset && firstIndex == pending.firstIndex + pending.indexCount)
+            {
+                pending.indexCount += pcmd->ElemCount;
+                continue;
+            }
+
+            flush();
+
+            if (!sameScissor)
+            {
+                vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+                boundScissor = scissor;
+                scissorBound = true;
+            }
+
+            if (!sameDescriptorSet)
+            {
+                auto itr = bindlessActive ? _bindless.indices.find(descriptorSet) : _bindless.indices.end();
+                if (itr != _bindless.indices.end())
+                {
+                    // registered textures only need their index pushing once the descriptor array is bound
+                    if (!bindlessPipelineBound)
+                    {
+                        bindBindlessGraphicsPipeline->record(commandBuffer);
+                        bindlessPipelineBound = true;
+                    }
+                    if (!bindlessDescriptorSetBound)
+                    {
+                        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vk_bindlessPipelineLayout, 0, 1, &frame.bindlessDescriptorSet, 0, nullptr);
+                        bindlessDescriptorSetBound = true;
+                        ++numDescriptorSetBinds;
+                    }
+                    vkCmdPushConstants(commandBuffer, vk_bindlessPipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 128, sizeof(uint32_t), &(itr->second));
+                }
+                else
+                {
+                    if (bindlessPipelineBound)
+                    {
+                        bindGraphicsPipeline->record(commandBuffer);
+                        bindlessPipelineBound = false;
+                    }
+                    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vk_pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+                    bindlessDescriptorSetBound = false;
+                    ++numDescriptorSetBinds;
+                }
+                boundDescriptorSet = descriptorSet;
+            }
+
+            pending.indexCount = pcmd->ElemCount;
+            pending.firstIndex = firstIndex;
+            pending.vertexOffset = vertexOffset;
+        }
+        global_idx_offset += cmd_list->IdxBuffer.Size;
+        global_vtx_offset += cmd_list->VtxBuffer.Size;
+    }
+
+    flush();
+
+    {
+        std::scoped_lock<std::mutex> lock(_recordStatsMutex);
+        _recordStats.numDrawCommands = numDrawCommands;
+        _recordStats.totalDrawCommands += numDrawCommands;
+        _recordStats.numDrawCalls = numDrawCalls;
+        _recordStats.totalDrawCalls += numDrawCalls;
+        _recordStats.numDescriptorSetBinds = numDescriptorSetBinds;
+    }
+
+    if (timestampSlot)
+    {
+        uint32_t firstQuery = static_cast<uint32_t>(timestampSlot - _timestamps.slots.data()) * 2;
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _timestamps.queryPool, firstQuery + 1);
+
+        timestampSlot->sample = FrameSample{0.0, numDrawCalls, static_cast<uint32_t>(drawData->TotalVtxCount), static_cast<uint32_t>(drawData->TotalIdxCount), numDescriptorSetBinds};
+        timestampSlot->pending = true;
+    }
+
+    state.modelviewMatrixStack.pop();
+    state.projectionMatrixStack.pop();
+    state.pop(pipeline);
+
+    // descriptor sets have been bound directly so make sure any subsequent scene graph state gets re-applied
+    for (auto& stateStack : state.stateStacks) stateStack.dirty = true;
+    state.dirty = true;
+}
@@ -0,0 +1,55 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/DrawDataSnapshot.h>
+
+using namespace vsgImGui;
+
+DrawDataSnapshot::DrawDataSnapshot(const ImDrawData* in_drawData)
+{
+    if (!in_drawData) return;
+
+    drawData.Valid = in_drawData->Valid;
+    drawData.TotalIdxCount = in_drawData->TotalIdxCount;
+    drawData.TotalVtxCount = in_drawData->TotalVtxCount;
+    drawData.DisplayPos = in_drawData->DisplayPos;
+    drawData.DisplaySize = in_drawData->DisplaySize;
+    drawData.FramebufferScale = in_drawData->FramebufferScale;
+
+    // CloneOutput() copies the command, index and vertex buffers, leaving out the transient state used while building
+    drawData.CmdLists.reserve(in_drawData->CmdLists.Size);
+    for (auto cmdList : in_drawData->CmdLists)
+    {
+        drawData.CmdLists.push_back(cmdList->CloneOutput());
+    }
+    drawData.CmdListsCount = drawData.CmdLists.Size;
+}
+
+DrawDataSnapshot::~DrawDataSnapshot()
+{
+    for (auto cmdList : drawData.CmdLists)
+    {
+        IM_DELETE(cmdList);
+    }
+    drawData.Clear();
+}
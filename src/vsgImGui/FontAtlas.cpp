@@ -0,0 +1,790 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/FontAtlas.h>
+#include <vsgImGui/imgui_internal.h>
+
+#include <vsg/commands/Command.h>
+#include <vsg/core/Array.h>
+#include <vsg/core/Array2D.h>
+#include <vsg/core/Objects.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/read.h>
+#include <vsg/io/write.h>
+#include <vsg/state/Buffer.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/Fence.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+// imgui_draw.cpp compiles stb_truetype and stb_rect_pack with static linkage, so compile our own static copies for the dynamic glyphs
+#if defined(__clang__) || defined(__GNUC__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "../imgui/imstb_rectpack.h"
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../imgui/imstb_truetype.h"
+#if defined(__clang__) || defined(__GNUC__)
+#    pragma GCC diagnostic pop
+#endif
+
+using namespace vsgImGui;
+
+namespace
+{
+    const uint32_t cacheVersion = 1;
+
+    inline uint64_t hash_combine(uint64_t seed, uint64_t value)
+    {
+        seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+
+    uint64_t hash_bytes(uint64_t seed, const void* ptr, size_t size)
+    {
+        // FNV-1a, only run once per atlas build so simplicity wins over speed
+        auto bytes = static_cast<const uint8_t*>(ptr);
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (size_t i = 0; i < size; ++i)
+        {
+            h = (h ^ bytes[i]) * 0x100000001b3ull;
+        }
+        return hash_combine(seed, h);
+    }
+
+    /// copy the staged dirty rectangles of the atlas, the image is kept in VK_IMAGE_LAYOUT_GENERAL so no layout transitions are needed
+    /// and the in flight frames sampling other parts of the atlas are unaffected.
+    class CopyGlyphRegions : public vsg::Inherit<vsg::Command, CopyGlyphRegions>
+    {
+    public:
+        vsg::ref_ptr<vsg::Buffer> source;
+        vsg::ref_ptr<vsg::Image> destination;
+        std::vector<VkBufferImageCopy> regions;
+
+        void record(vsg::CommandBuffer& commandBuffer) const override
+        {
+            VkImageMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = destination->vk(commandBuffer.deviceID);
+            barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            vkCmdCopyBufferToImage(commandBuffer, source->vk(commandBuffer.deviceID), barrier.image, VK_IMAGE_LAYOUT_GENERAL, static_cast<uint32_t>(regions.size()), regions.data());
+
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        }
+    };
+
+    template<typename T>
+    vsg::ref_ptr<vsg::ubyteArray> copyToArray(const ImVector<T>& vector)
+    {
+        auto array = vsg::ubyteArray::create(static_cast<uint32_t>(vector.Size * sizeof(T)));
+        if (vector.Size > 0) std::memcpy(array->dataPointer(), vector.Data, array->dataSize());
+        return array;
+    }
+
+    template<typename T>
+    bool copyFromArray(const vsg::ubyteArray* array, ImVector<T>& vector)
+    {
+        if (!array || (array->dataSize() % sizeof(T)) != 0) return false;
+        vector.resize(static_cast<int>(array->dataSize() / sizeof(T)));
+        if (vector.Size > 0) std::memcpy(vector.Data, array->dataPointer(), array->dataSize());
+        return true;
+    }
+
+    // placeholder glyphs are zero sized quads that draw nothing, U holds their codepoint and a negative V the index of their font
+    inline bool isPlaceholder(const ImFontGlyph* glyph)
+    {
+        return glyph && glyph->V0 < 0.0f;
+    }
+
+    // matches the adjustments ImFont::AddGlyph() makes to the advance
+    float adjustedAdvance(const ImFontConfig& config, float advanceX)
+    {
+        advanceX = ImClamp(advanceX, config.GlyphMinAdvanceX, config.GlyphMaxAdvanceX);
+        if (config.PixelSnapH) advanceX = IM_ROUND(advanceX);
+        return advanceX + config.GlyphExtraSpacing.x;
+    }
+} // namespace
+
+struct FontAtlas::DynamicGlyphs
+{
+    int originX = 0;
+    int originY = 0;
+    stbrp_context packContext;
+    std::vector<stbrp_node> packNodes;
+
+    // one entry per ImFontAtlas::ConfigData, invalid when the font data has been released with ImFontAtlas::ClearInputData()
+    std::vector<stbtt_fontinfo> fontInfos;
+    std::vector<bool> validFontInfos;
+
+    vsg::ref_ptr<vsg::Buffer> stagingBuffer;
+    VkDeviceSize stagingSize = 0;
+
+    // glyphs rasterized into the staging buffer, applied to their fonts once the copy to the atlas image has completed
+    struct StagedGlyph
+    {
+        ImFont* font = nullptr;
+        const ImFontConfig* config = nullptr;
+        ImWchar codepoint = 0;
+        float x0 = 0.0f, y0 = 0.0f, x1 = 0.0f, y1 = 0.0f;
+        float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+        float advanceX = 0.0f;
+    };
+    std::vector<StagedGlyph> stagedGlyphs;
+
+    // context whose submission is copying the staged glyphs, only one copy is in flight at a time
+    vsg::ref_ptr<vsg::Context> uploadContext;
+};
+
+FontAtlas::FontAtlas(ImFontAtlas* in_atlas, vsg::ref_ptr<DescriptorPools> in_descriptorPools, vsg::ref_ptr<vsg::DescriptorSetLayout> in_descriptorSetLayout) :
+    atlas(in_atlas),
+    descriptorPools(in_descriptorPools),
+    descriptorSetLayout(in_descriptorSetLayout)
+{
+    sampler = vsg::Sampler::create();
+    sampler->addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler->addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler->addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler->maxLod = 0.0f; // glyphs are rendered 1:1 so no need for mipmaps
+}
+
+FontAtlas::~FontAtlas()
+{
+    if (_descriptorSet) descriptorPools->free(_descriptorSet);
+    if (ownsAtlas) IM_DELETE(atlas);
+}
+
+void FontAtlas::compile(vsg::Context& context)
+{
+    // the descriptor sets come from pools for a specific device, so only compile for that device
+    if (!atlas || context.device != descriptorPools->device || compiled(context.deviceID)) return;
+
+    auto deviceID = context.deviceID;
+
+    if (!image)
+    {
+        build();
+        if (dynamicGlyphs) _setupDynamicGlyphs();
+
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+        _pixels = vsg::ubvec4Array2D::create(width, height, vsg::Data::Properties{VK_FORMAT_R8G8B8A8_UNORM});
+        std::memcpy(_pixels->dataPointer(), pixels, _pixels->dataSize());
+
+        // dynamic glyphs are copied into the atlas while earlier frames may still be sampling it, so avoid layout transitions by keeping it GENERAL
+        auto imageLayout = dynamicGlyphs ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        image = vsg::DescriptorImage::create(vsg::ImageInfo::create(sampler, _pixels, imageLayout), 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    }
+
+    // queues the transfer of the pixels on the context rather than submitting it immediately
+    image->compile(context);
+    descriptorSetLayout->compile(context);
+
+    // ImTextureID is a VkDescriptorSet so allocate one directly, in the same form as vsgImGui::Texture provides.
+    _descriptorSet = descriptorPools->allocate(descriptorSetLayout->vk(deviceID));
+    if (!_descriptorSet) return;
+
+    auto& imageInfo = image->imageInfoList.front();
+    VkDescriptorImageInfo descriptorImageInfo = {};
+    descriptorImageInfo.sampler = imageInfo->sampler->vk(deviceID);
+    descriptorImageInfo.imageView = imageInfo->imageView->vk(deviceID);
+    descriptorImageInfo.imageLayout = imageInfo->imageLayout;
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = _descriptorSet;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &descriptorImageInfo;
+    vkUpdateDescriptorSets(*context.device, 1, &write, 0, nullptr);
+
+    _deviceID = deviceID;
+    if (assignTexID) atlas->SetTexID(_descriptorSet);
+}
+
+uint64_t FontAtlas::configurationHash() const
+{
+    uint64_t seed = hash_combine(IMGUI_VERSION_NUM, cacheVersion);
+    seed = hash_combine(seed, sizeof(ImFontConfig));
+    seed = hash_combine(seed, sizeof(ImFontGlyph));
+    seed = hash_combine(seed, static_cast<uint64_t>(atlas->Flags));
+    seed = hash_combine(seed, static_cast<uint64_t>(atlas->TexDesiredWidth));
+    seed = hash_combine(seed, static_cast<uint64_t>(atlas->TexGlyphPadding));
+
+    for (const auto& config : atlas->ConfigData)
+    {
+        // hash the settings with the pointers cleared, ImFontConfig is memset on construction so the padding is deterministic
+        ImFontConfig settings;
+        std::memcpy(static_cast<void*>(&settings), &config, sizeof(ImFontConfig));
+        settings.FontData = nullptr;
+        settings.GlyphRanges = nullptr;
+        settings.DstFont = nullptr;
+        seed = hash_bytes(seed, &settings, sizeof(ImFontConfig));
+
+        seed = hash_bytes(seed, config.FontData, static_cast<size_t>(config.FontDataSize));
+
+        seed = hash_combine(seed, static_cast<uint64_t>(atlas->Fonts.index_from_ptr(std::find(atlas->Fonts.begin(), atlas->Fonts.end(), config.DstFont))));
+
+        if (const ImWchar* ranges = config.GlyphRanges ? config.GlyphRanges : atlas->GetGlyphRangesDefault())
+        {
+            for (; ranges[0]; ranges += 2)
+            {
+                seed = hash_combine(seed, (static_cast<uint64_t>(ranges[0]) << 32) | ranges[1]);
+            }
+        }
+    }
+
+    for (const auto& rect : atlas->CustomRects)
+    {
+        seed = hash_combine(seed, (static_cast<uint64_t>(rect.Width) << 16) | rect.Height);
+        seed = hash_combine(seed, rect.GlyphID);
+    }
+
+    return seed;
+}
+
+void FontAtlas::build()
+{
+    if (atlas->IsBuilt())
+    {
+        if (dynamicGlyphs && _dynamicRectIndex < 0) vsg::warn("vsgImGui::FontAtlas::dynamicGlyphs set after the atlas was built, no region reserved for dynamic glyphs.");
+        return;
+    }
+
+    // matches ImFontAtlas::Build(), the default font has to be added before the configuration can be hashed
+    if (atlas->ConfigData.Size == 0) atlas->AddFontDefault();
+
+    // reserve the region for the dynamic glyphs, widening the atlas if required so the region can be packed
+    if (dynamicGlyphs && _dynamicRectIndex < 0)
+    {
+        int requiredWidth = static_cast<int>(dynamicRegionSize.width) + atlas->TexGlyphPadding;
+        if (atlas->TexDesiredWidth < requiredWidth) atlas->TexDesiredWidth = ImUpperPowerOfTwo(requiredWidth);
+        _dynamicRectIndex = atlas->AddCustomRectRegular(static_cast<int>(dynamicRegionSize.width), static_cast<int>(dynamicRegionSize.height));
+    }
+
+    vsg::Path filename;
+    if (!cacheDirectory.empty())
+    {
+        std::ostringstream str;
+        str << "vsgImGui_FontAtlas_" << std::hex << configurationHash() << ".vsgb";
+        filename = cacheDirectory / str.str();
+
+        if (_readCache(filename))
+        {
+            vsg::debug("vsgImGui::FontAtlas read baked atlas from ", filename);
+            return;
+        }
+    }
+
+    atlas->Build();
+
+    if (!filename.empty() && !_writeCache(filename))
+    {
+        vsg::warn("vsgImGui::FontAtlas unable to write cache ", filename);
+    }
+}
+
+bool FontAtlas::_writeCache(const vsg::Path& filename) const
+{
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+    if (!pixels) return false;
+
+    auto cache = vsg::Objects::create();
+    cache->setValue("version", cacheVersion);
+
+    auto alpha = vsg::ubyteArray2D::create(width, height, vsg::Data::Properties{VK_FORMAT_R8_UNORM});
+    std::memcpy(alpha->dataPointer(), pixels, alpha->dataSize());
+    cache->setObject("pixels", alpha);
+
+    auto uvs = vsg::vec4Array::create(2 + IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1);
+    uvs->at(0).set(atlas->TexUvScale.x, atlas->TexUvScale.y, 0.0f, 0.0f);
+    uvs->at(1).set(atlas->TexUvWhitePixel.x, atlas->TexUvWhitePixel.y, 0.0f, 0.0f);
+    for (int i = 0; i <= IM_DRAWLIST_TEX_LINES_WIDTH_MAX; ++i)
+    {
+        const auto& line = atlas->TexUvLines[i];
+        uvs->at(2 + i).set(line.x, line.y, line.z, line.w);
+    }
+    cache->setObject("uvs", uvs);
+
+    // custom rects reference their font by pointer so store the index separately
+    auto customRectFonts = vsg::intArray::create(atlas->CustomRects.Size);
+    for (int i = 0; i < atlas->CustomRects.Size; ++i)
+    {
+        customRectFonts->at(i) = atlas->CustomRects[i].Font ? atlas->Fonts.index_from_ptr(std::find(atlas->Fonts.begin(), atlas->Fonts.end(), atlas->CustomRects[i].Font)) : -1;
+    }
+    cache->setObject("customRects", copyToArray(atlas->CustomRects));
+    cache->setObject("customRectFonts", customRectFonts);
+    cache->setObject("packIds", vsg::intArray::create({atlas->PackIdMouseCursors, atlas->PackIdLines}));
+
+    for (int i = 0; i < atlas->Fonts.Size; ++i)
+    {
+        const ImFont* font = atlas->Fonts[i];
+        auto prefix = std::string("font_") + std::to_string(i) + "_";
+        cache->setObject(prefix + "glyphs", copyToArray(font->Glyphs));
+        cache->setObject(prefix + "metrics", vsg::floatArray::create({font->FontSize, font->Ascent, font->Descent}));
+        cache->setObject(prefix + "chars", vsg::intArray::create({static_cast<int>(font->FallbackChar), static_cast<int>(font->EllipsisChar), font->MetricsTotalSurface}));
+    }
+
+    return vsg::write(cache, filename, options);
+}
+
+bool FontAtlas::_readCache(const vsg::Path& filename)
+{
+    auto cache = vsg::read_cast<vsg::Objects>(filename, options);
+    if (!cache) return false;
+
+    uint32_t version = 0;
+    if (!cache->getValue("version", version) || version != cacheVersion) return false;
+
+    auto alpha = cache->getObject<vsg::ubyteArray2D>("pixels");
+    auto uvs = cache->getObject<vsg::vec4Array>("uvs");
+    auto customRectFonts = cache->getObject<vsg::intArray>("customRectFonts");
+    auto packIds = cache->getObject<vsg::intArray>("packIds");
+    if (!alpha || !uvs || uvs->size() != (2 + IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1) || !customRectFonts || !packIds || packIds->size() != 2) return false;
+
+    // validate the per font entries before modifying the atlas
+    for (int i = 0; i < atlas->Fonts.Size; ++i)
+    {
+        auto prefix = std::string("font_") + std::to_string(i) + "_";
+        auto metrics = cache->getObject<vsg::floatArray>(prefix + "metrics");
+        auto chars = cache->getObject<vsg::intArray>(prefix + "chars");
+        if (!cache->getObject<vsg::ubyteArray>(prefix + "glyphs") || !metrics || metrics->size() != 3 || !chars || chars->size() != 3) return false;
+    }
+
+    ImVector<ImFontAtlasCustomRect> customRects;
+    if (!copyFromArray(cache->getObject<vsg::ubyteArray>("customRects"), customRects) || customRects.Size != static_cast<int>(customRectFonts->size())) return false;
+
+    // equivalent of ImFontAtlasBuildSetupFont() for each of the fonts
+    for (auto& config : atlas->ConfigData)
+    {
+        ImFont* font = config.DstFont;
+        if (!config.MergeMode)
+        {
+            font->ClearOutputData();
+            font->FontSize = config.SizePixels;
+            font->ConfigData = &config;
+            font->ConfigDataCount = 0;
+            font->ContainerAtlas = atlas;
+        }
+        font->ConfigDataCount++;
+    }
+
+    for (int i = 0; i < atlas->Fonts.Size; ++i)
+    {
+        ImFont* font = atlas->Fonts[i];
+        auto prefix = std::string("font_") + std::to_string(i) + "_";
+        auto metrics = cache->getObject<vsg::floatArray>(prefix + "metrics");
+        auto chars = cache->getObject<vsg::intArray>(prefix + "chars");
+
+        copyFromArray(cache->getObject<vsg::ubyteArray>(prefix + "glyphs"), font->Glyphs);
+        font->FontSize = metrics->at(0);
+        font->Ascent = metrics->at(1);
+        font->Descent = metrics->at(2);
+        font->FallbackChar = static_cast<ImWchar>(chars->at(0));
+        font->EllipsisChar = static_cast<ImWchar>(chars->at(1));
+        font->MetricsTotalSurface = chars->at(2);
+        font->BuildLookupTable();
+    }
+
+    atlas->CustomRects = customRects;
+    for (int i = 0; i < atlas->CustomRects.Size; ++i)
+    {
+        int fontIndex = customRectFonts->at(i);
+        atlas->CustomRects[i].Font = (fontIndex >= 0 && fontIndex < atlas->Fonts.Size) ? atlas->Fonts[fontIndex] : nullptr;
+    }
+    atlas->PackIdMouseCursors = packIds->at(0);
+    atlas->PackIdLines = packIds->at(1);
+
+    atlas->ClearTexData();
+    atlas->TexWidth = static_cast<int>(alpha->width());
+    atlas->TexHeight = static_cast<int>(alpha->height());
+    atlas->TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(alpha->dataSize()));
+    std::memcpy(atlas->TexPixelsAlpha8, alpha->dataPointer(), alpha->dataSize());
+
+    atlas->TexUvScale = ImVec2(uvs->at(0).x, uvs->at(0).y);
+    atlas->TexUvWhitePixel = ImVec2(uvs->at(1).x, uvs->at(1).y);
+    for (int i = 0; i <= IM_DRAWLIST_TEX_LINES_WIDTH_MAX; ++i)
+    {
+        const auto& line = uvs->at(2 + i);
+        atlas->TexUvLines[i] = ImVec4(line.x, line.y, line.z, line.w);
+    }
+    atlas->TexReady = true;
+
+    return true;
+}
+
+void FontAtlas::requestGlyphs(const char* text, const char* text_end, const ImFont* font)
+{
+    if (!dynamicGlyphs || !text) return;
+    if (!text_end) text_end = text + std::strlen(text);
+
+    while (text < text_end)
+    {
+        unsigned int c = 0;
+        text += ImTextCharFromUtf8(&c, text, text_end);
+        if (c == 0) break;
+        if (c >= 0x20 && c <= IM_UNICODE_CODEPOINT_MAX) requestGlyph(static_cast<ImWchar>(c), font);
+    }
+}
+
+void FontAtlas::requestGlyph(ImWchar c, const ImFont* font)
+{
+    if (!dynamicGlyphs) return;
+    if (font)
+    {
+        auto glyph = font->FindGlyphNoFallback(c);
+        if (glyph && !isPlaceholder(glyph)) return;
+    }
+
+    std::scoped_lock<std::mutex> lock(_glyphMutex);
+
+    // the same placeholder is usually found several times in a frame, and again on the frames until its glyph is available
+    std::pair<const ImFont*, ImWchar> request(font, c);
+    if (!_pendingGlyphs.empty() && _pendingGlyphs.back() == request) return;
+
+    _pendingGlyphs.push_back(request);
+}
+
+void FontAtlas::_setupDynamicGlyphs()
+{
+    if (_dynamicGlyphs) return;
+
+    const ImFontAtlasCustomRect* rect = (_dynamicRectIndex >= 0) ? atlas->GetCustomRectByIndex(_dynamicRectIndex) : nullptr;
+    if (!rect || !rect->IsPacked())
+    {
+        vsg::warn("vsgImGui::FontAtlas no dynamic glyph region in atlas, unable to add glyphs.");
+        dynamicGlyphs = false;
+        return;
+    }
+
+    _dynamicGlyphs = std::make_unique<DynamicGlyphs>();
+    auto& dynamic = *_dynamicGlyphs;
+    dynamic.originX = rect->X;
+    dynamic.originY = rect->Y;
+    dynamic.packNodes.resize(rect->Width);
+    stbrp_init_target(&dynamic.packContext, rect->Width, rect->Height, dynamic.packNodes.data(), rect->Width);
+
+    // the font data is only parsed here, no glyphs are created until they are requested
+    dynamic.fontInfos.resize(atlas->ConfigData.Size);
+    dynamic.validFontInfos.resize(atlas->ConfigData.Size);
+    for (int i = 0; i < atlas->ConfigData.Size; ++i)
+    {
+        auto fontData = static_cast<const unsigned char*>(atlas->ConfigData[i].FontData);
+        int offset = fontData ? stbtt_GetFontOffsetForIndex(fontData, atlas->ConfigData[i].FontNo) : -1;
+        dynamic.validFontInfos[i] = offset >= 0 && stbtt_InitFont(&dynamic.fontInfos[i], fontData, offset) != 0;
+    }
+}
+
+void FontAtlas::_addPlaceholders()
+{
+    // give the staged glyphs zero sized placeholders with the final advance, so text is laid out correctly while the copy is in flight
+    std::vector<ImFont*> modifiedFonts;
+    for (auto& staged : _dynamicGlyphs->stagedGlyphs)
+    {
+        ImFont* font = staged.font;
+        if (font->FindGlyphNoFallback(staged.codepoint)) continue;
+
+        // BuildLookupTable() appends a TAB glyph that it only recognizes when it's the last glyph
+        if (std::find(modifiedFonts.begin(), modifiedFonts.end(), font) == modifiedFonts.end())
+        {
+            if (!font->Glyphs.empty() && font->Glyphs.back().Codepoint == '\t') font->Glyphs.pop_back();
+            modifiedFonts.push_back(font);
+        }
+
+        int fontIndex = atlas->Fonts.index_from_ptr(std::find(atlas->Fonts.begin(), atlas->Fonts.end(), font));
+
+        ImFontGlyph glyph = {};
+        glyph.Codepoint = staged.codepoint;
+        glyph.Visible = 1;
+        glyph.AdvanceX = adjustedAdvance(*staged.config, staged.advanceX);
+        glyph.U0 = glyph.U1 = static_cast<float>(staged.codepoint);
+        glyph.V0 = glyph.V1 = -static_cast<float>(fontIndex + 1);
+        font->Glyphs.push_back(glyph);
+    }
+
+    for (auto* font : modifiedFonts) font->BuildLookupTable();
+}
+
+bool FontAtlas::update(vsg::Context& context)
+{
+    if (!dynamicGlyphs || !compiled(context.deviceID)) return false;
+
+    // the atlas may be shared by contexts updated from different threads
+    std::scoped_lock<std::mutex> lock(_glyphMutex);
+
+    if (_dynamicGlyphs && _dynamicGlyphs->uploadContext)
+    {
+        // never wait on the copy, the placeholders remain until it has completed
+        auto& uploadContext = _dynamicGlyphs->uploadContext;
+        if (uploadContext->fence && uploadContext->fence->status() == VK_NOT_READY) return false;
+
+        uploadContext->waitForCompletion();
+        uploadContext = {};
+        return _applyStagedGlyphs();
+    }
+
+    if (_pendingGlyphs.empty()) return false;
+
+    auto pending = std::move(_pendingGlyphs);
+    _pendingGlyphs.clear();
+
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+    _setupDynamicGlyphs();
+    if (!_dynamicGlyphs)
+    {
+        _dynamicGlyphStats.numMissingGlyphs += static_cast<uint32_t>(pending.size());
+        return false;
+    }
+
+    auto& dynamic = *_dynamicGlyphs;
+    const int padding = atlas->TexGlyphPadding;
+    const float uScale = 1.0f / static_cast<float>(atlas->TexWidth);
+    const float vScale = 1.0f / static_cast<float>(atlas->TexHeight);
+
+    std::vector<VkBufferImageCopy> regions;
+    std::vector<vsg::ubvec4> staging;
+    std::vector<unsigned char> bitmap;
+
+    auto addGlyph = [&](ImFont* font, ImWchar c) {
+        auto existing = font->FindGlyphNoFallback(c);
+        if (existing && !isPlaceholder(existing)) return;
+
+        // a glyph requested for all fonts and for its own font may already be staged
+        for (auto& staged : dynamic.stagedGlyphs)
+        {
+            if (staged.font == font && staged.codepoint == c) return;
+        }
+
+        // find the first of the font's sources that provides the glyph, in the order they were merged
+        int configIndex = -1;
+        int glyphIndex = 0;
+        for (int i = 0; i < atlas->ConfigData.Size && glyphIndex == 0; ++i)
+        {
+            if (atlas->ConfigData[i].DstFont != font || !dynamic.validFontInfos[i]) continue;
+            glyphIndex = stbtt_FindGlyphIndex(&dynamic.fontInfos[i], c);
+            configIndex = i;
+        }
+
+        if (glyphIndex == 0)
+        {
+            ++_dynamicGlyphStats.numMissingGlyphs;
+            return;
+        }
+
+        // matches the scaling and placement used by ImFontAtlasBuildWithStbTruetype(), without oversampling
+        const ImFontConfig& config = atlas->ConfigData[configIndex];
+        const stbtt_fontinfo* info = &dynamic.fontInfos[configIndex];
+        const float scale = (config.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(info, config.SizePixels * config.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(info, -config.SizePixels * config.RasterizerDensity);
+        const float inverseDensity = 1.0f / config.RasterizerDensity;
+
+        int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+        stbtt_GetGlyphBitmapBox(info, glyphIndex, scale, scale, &x0, &y0, &x1, &y1);
+        int width = x1 - x0;
+        int height = y1 - y0;
+
+        int advance = 0, leftSideBearing = 0;
+        stbtt_GetGlyphHMetrics(info, glyphIndex, &advance, &leftSideBearing);
+
+        int tx = 0, ty = 0;
+        if (width > 0 && height > 0)
+        {
+            stbrp_rect rect = {};
+            rect.w = static_cast<stbrp_coord>(width + padding);
+            rect.h = static_cast<stbrp_coord>(height + padding);
+            stbrp_pack_rects(&dynamic.packContext, &rect, 1);
+            if (!rect.was_packed)
+            {
+                ++_dynamicGlyphStats.numMissingGlyphs;
+                return;
+            }
+
+            tx = dynamic.originX + rect.x;
+            ty = dynamic.originY + rect.y;
+
+            bitmap.resize(static_cast<size_t>(width) * height);
+            stbtt_MakeGlyphBitmap(info, bitmap.data(), width, height, width, scale, scale, glyphIndex);
+            if (config.RasterizerMultiply != 1.0f)
+            {
+                for (auto& value : bitmap) value = static_cast<unsigned char>(std::min(255.0f, static_cast<float>(value) * config.RasterizerMultiply));
+            }
+
+            VkBufferImageCopy region = {};
+            region.bufferOffset = staging.size() * sizeof(vsg::ubvec4);
+            region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            region.imageOffset = {tx, ty, 0};
+            region.imageExtent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1};
+            regions.push_back(region);
+
+            // keep the CPU copies of the atlas in sync so later compiles and cache writes include the glyph
+            auto rgba32 = reinterpret_cast<unsigned int*>(atlas->TexPixelsRGBA32);
+            for (int r = 0; r < height; ++r)
+            {
+                const unsigned char* row = bitmap.data() + r * width;
+                size_t index = static_cast<size_t>(ty + r) * atlas->TexWidth + tx;
+                if (atlas->TexPixelsAlpha8) std::memcpy(atlas->TexPixelsAlpha8 + index, row, width);
+                for (int col = 0; col < width; ++col)
+                {
+                    vsg::ubvec4 texel(255, 255, 255, row[col]);
+                    staging.push_back(texel);
+                    _pixels->at(tx + col, ty + r) = texel;
+                    if (rgba32) rgba32[index + col] = IM_COL32(255, 255, 255, row[col]);
+                }
+            }
+        }
+
+        const float offsetX = config.GlyphOffset.x;
+        const float offsetY = config.GlyphOffset.y + IM_ROUND(font->Ascent);
+
+        DynamicGlyphs::StagedGlyph staged;
+        staged.font = font;
+        staged.config = &config;
+        staged.codepoint = c;
+        staged.x0 = static_cast<float>(x0) * inverseDensity + offsetX;
+        staged.y0 = static_cast<float>(y0) * inverseDensity + offsetY;
+        staged.x1 = static_cast<float>(x1) * inverseDensity + offsetX;
+        staged.y1 = static_cast<float>(y1) * inverseDensity + offsetY;
+        staged.u0 = tx * uScale;
+        staged.v0 = ty * vScale;
+        staged.u1 = (tx + width) * uScale;
+        staged.v1 = (ty + height) * vScale;
+        staged.advanceX = static_cast<float>(advance) * scale * inverseDensity;
+        dynamic.stagedGlyphs.push_back(staged);
+    };
+
+    for (auto& [font, c] : pending)
+    {
+        if (font)
+        {
+            addGlyph(const_cast<ImFont*>(font), c);
+        }
+        else
+        {
+            for (auto* atlasFont : atlas->Fonts) addGlyph(atlasFont, c);
+        }
+    }
+
+    // glyphs without pixels, such as spaces, don't need copying
+    if (regions.empty()) return _applyStagedGlyphs();
+
+    auto device = context.device;
+    auto deviceID = context.deviceID;
+    VkDeviceSize size = staging.size() * sizeof(vsg::ubvec4);
+    if (size > dynamic.stagingSize)
+    {
+        dynamic.stagingSize = std::max(size, dynamic.stagingSize * 2);
+        dynamic.stagingBuffer = vsg::createBufferAndMemory(device, dynamic.stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    }
+
+    auto memory = dynamic.stagingBuffer->getDeviceMemory(deviceID);
+    void* mapped = nullptr;
+    if (memory->map(dynamic.stagingBuffer->getMemoryOffset(deviceID), size, 0, &mapped) != VK_SUCCESS)
+    {
+        vsg::warn("vsgImGui::FontAtlas unable to map staging buffer for dynamic glyphs.");
+        _dynamicGlyphStats.numMissingGlyphs += static_cast<uint32_t>(dynamic.stagedGlyphs.size());
+        dynamic.stagedGlyphs.clear();
+        return false;
+    }
+    std::memcpy(mapped, staging.data(), size);
+    memory->unmap();
+
+    auto copy = CopyGlyphRegions::create();
+    copy->source = dynamic.stagingBuffer;
+    copy->destination = image->imageInfoList.front()->imageView->image;
+    copy->regions = std::move(regions);
+
+    _dynamicGlyphStats.numUploadedRects += static_cast<uint32_t>(copy->regions.size());
+    _dynamicGlyphStats.uploadedBytes += size;
+    ++_dynamicGlyphStats.numUploads;
+
+    // submit the copy without waiting for it, the staged glyphs are applied by a later update(..) once it has completed.
+    // As only one copy is in flight at a time the staging buffer can be reused by the next one.
+    context.commands.push_back(copy);
+    context.record();
+    dynamic.uploadContext = vsg::ref_ptr<vsg::Context>(&context);
+
+    _addPlaceholders();
+
+    return false;
+}
+
+bool FontAtlas::_applyStagedGlyphs()
+{
+    auto& stagedGlyphs = _dynamicGlyphs->stagedGlyphs;
+    if (stagedGlyphs.empty()) return false;
+
+    std::vector<ImFont*> modifiedFonts;
+    for (auto& staged : stagedGlyphs)
+    {
+        ImFont* font = staged.font;
+        auto placeholder = font->FindGlyphNoFallback(staged.codepoint);
+
+        // AddGlyph() may reallocate Glyphs, so hold the placeholder's index rather than a pointer to it
+        int placeholderIndex = isPlaceholder(placeholder) ? static_cast<int>(placeholder - font->Glyphs.Data) : -1;
+
+        // BuildLookupTable() appends a TAB glyph that it only recognizes when it's the last glyph, so remove it before adding new glyphs
+        bool rebuildLookup = placeholderIndex < 0;
+        if (rebuildLookup && std::find(modifiedFonts.begin(), modifiedFonts.end(), font) == modifiedFonts.end())
+        {
+            if (!font->Glyphs.empty() && font->Glyphs.back().Codepoint == '\t') font->Glyphs.pop_back();
+            modifiedFonts.push_back(font);
+        }
+
+        font->AddGlyph(staged.config, staged.codepoint, staged.x0, staged.y0, staged.x1, staged.y1, staged.u0, staged.v0, staged.u1, staged.v1, staged.advanceX);
+
+        if (!rebuildLookup)
+        {
+            // replace the placeholder in place so the lookup tables stay valid without being rebuilt
+            auto& glyph = font->Glyphs[placeholderIndex];
+            glyph = font->Glyphs.back();
+            font->Glyphs.pop_back();
+            font->IndexAdvanceX[staged.codepoint] = glyph.AdvanceX;
+        }
+        ++_dynamicGlyphStats.numGlyphs;
+    }
+    stagedGlyphs.clear();
+
+    for (auto* font : modifiedFonts) font->BuildLookupTable();
+
+    return true;
+}
@@ -0,0 +1,237 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/IconAtlas.h>
+
+#include <vsg/core/Array2D.h>
+#include <vsg/io/Logger.h>
+
+#include <cstring>
+
+// imgui_draw.cpp compiles stb_rect_pack with static linkage, so compile our own static copy
+#if defined(__clang__) || defined(__GNUC__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "../imgui/imstb_rectpack.h"
+#if defined(__clang__) || defined(__GNUC__)
+#    pragma GCC diagnostic pop
+#endif
+
+using namespace vsgImGui;
+
+namespace
+{
+    // return the image as VK_FORMAT_R8G8B8A8_UNORM texels, the format of the pages, swizzling BGRA images, or null if the format can't be converted.
+    // sRGB images keep their encoded values, ImGui treats its own colours as sRGB bytes in UNORM targets so the icons match them, and decoding
+    // to 8 bit linear values would band dark gradients. Images without a format are assumed to already be RGBA.
+    vsg::ref_ptr<vsg::Data> convertToPageFormat(vsg::ref_ptr<vsg::Data> image)
+    {
+        auto format = image->properties.format;
+        if (format == VK_FORMAT_R8G8B8A8_UNORM || format == VK_FORMAT_R8G8B8A8_SRGB || format == VK_FORMAT_UNDEFINED) return image;
+        if (format != VK_FORMAT_B8G8R8A8_UNORM && format != VK_FORMAT_B8G8R8A8_SRGB) return {};
+
+        auto converted = vsg::ubvec4Array2D::create(image->width(), image->height(), vsg::Data::Properties{VK_FORMAT_R8G8B8A8_UNORM});
+        auto source = static_cast<const uint8_t*>(image->dataPointer());
+        auto destination = static_cast<uint8_t*>(converted->dataPointer());
+        size_t numTexels = static_cast<size_t>(image->width()) * image->height();
+        for (size_t i = 0; i < numTexels; ++i, source += 4, destination += 4)
+        {
+            destination[0] = source[2];
+            destination[1] = source[1];
+            destination[2] = source[0];
+            destination[3] = source[3];
+        }
+        return converted;
+    }
+} // namespace
+
+struct IconAtlas::Packers
+{
+    struct Packer
+    {
+        stbrp_context context;
+        std::vector<stbrp_node> nodes;
+    };
+
+    // stbrp_context holds pointers to its nodes so each packer needs a stable address
+    std::vector<std::unique_ptr<Packer>> pages;
+};
+
+IconAtlas::IconAtlas(uint32_t in_pageWidth, uint32_t in_pageHeight, uint32_t in_padding) :
+    pageWidth(std::max(in_pageWidth, 1u)),
+    pageHeight(std::max(in_pageHeight, 1u)),
+    padding(in_padding),
+    _packers(std::make_unique<Packers>())
+{
+}
+
+IconAtlas::~IconAtlas()
+{
+}
+
+uint32_t IconAtlas::add(vsg::ref_ptr<vsg::Data> image)
+{
+    if (!image || image->properties.stride != 4 || image->width() == 0 || image->height() == 0)
+    {
+        vsg::warn("vsgImGui::IconAtlas::add(..) requires a 2D image with 4 bytes per texel.");
+        return invalidIcon;
+    }
+
+    auto converted = convertToPageFormat(image);
+    if (!converted)
+    {
+        vsg::warn("vsgImGui::IconAtlas::add(..) image format ", image->properties.format, " not supported, requires VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_B8G8R8A8_UNORM or their SRGB equivalents.");
+        return invalidIcon;
+    }
+    image = converted;
+
+    if (image->width() + padding > pageWidth || image->height() + padding > pageHeight)
+    {
+        vsg::warn("vsgImGui::IconAtlas::add(..) image of ", image->width(), "x", image->height(), " is too large for the ", pageWidth, "x", pageHeight, " pages.");
+        return invalidIcon;
+    }
+
+    Icon icon;
+    icon.size = ImVec2(static_cast<float>(image->width()), static_cast<float>(image->height()));
+
+    _icons.push_back(icon);
+    _pendingImages.push_back(image);
+    return static_cast<uint32_t>(_icons.size() - 1);
+}
+
+void IconAtlas::_addPage()
+{
+    auto packer = std::make_unique<Packers::Packer>();
+    packer->nodes.resize(pageWidth);
+    stbrp_init_target(&packer->context, static_cast<int>(pageWidth), static_cast<int>(pageHeight), packer->nodes.data(), static_cast<int>(pageWidth));
+    _packers->pages.push_back(std::move(packer));
+
+    auto data = vsg::ubvec4Array2D::create(pageWidth, pageHeight, vsg::Data::Properties{VK_FORMAT_R8G8B8A8_UNORM});
+    std::memset(data->dataPointer(), 0, data->dataSize());
+    _pageData.push_back(data);
+
+    // icons are drawn close to their native size so mipmaps aren't needed, and would blend neighbouring icons
+    auto sampler = vsg::Sampler::create();
+    sampler->maxLod = 0.0f;
+    sampler->addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler->addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler->addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+    pages.push_back(Texture::create(data, sampler));
+    _compiledPages.push_back(false);
+}
+
+void IconAtlas::pack()
+{
+    std::vector<stbrp_rect> rects;
+    for (size_t i = 0; i < _icons.size(); ++i)
+    {
+        if (_icons[i].packed || !_pendingImages[i]) continue;
+
+        stbrp_rect rect = {};
+        rect.id = static_cast<int>(i);
+        rect.w = static_cast<stbrp_coord>(_pendingImages[i]->width() + padding);
+        rect.h = static_cast<stbrp_coord>(_pendingImages[i]->height() + padding);
+        rects.push_back(rect);
+    }
+
+    // fill the existing pages before starting new ones
+    size_t pageIndex = 0;
+    while (!rects.empty())
+    {
+        if (pageIndex >= _packers->pages.size()) _addPage();
+
+        stbrp_pack_rects(&_packers->pages[pageIndex]->context, rects.data(), static_cast<int>(rects.size()));
+
+        auto& page = *_pageData[pageIndex];
+        auto pageTexels = static_cast<uint8_t*>(page.dataPointer());
+        size_t pageRowSize = static_cast<size_t>(pageWidth) * 4;
+
+        auto itr = rects.begin();
+        for (auto& rect : rects)
+        {
+            if (!rect.was_packed)
+            {
+                *itr++ = rect;
+                continue;
+            }
+
+            auto& icon = _icons[rect.id];
+            auto& image = *_pendingImages[rect.id];
+            uint32_t width = image.width();
+            uint32_t height = image.height();
+
+            auto source = static_cast<const uint8_t*>(image.dataPointer());
+            for (uint32_t row = 0; row < height; ++row)
+            {
+                std::memcpy(pageTexels + (rect.y + row) * pageRowSize + rect.x * 4, source + row * width * 4, width * 4);
+            }
+
+            icon.page = static_cast<uint32_t>(pageIndex);
+            icon.uv0 = ImVec2(static_cast<float>(rect.x) / static_cast<float>(pageWidth), static_cast<float>(rect.y) / static_cast<float>(pageHeight));
+            icon.uv1 = ImVec2(static_cast<float>(rect.x + width) / static_cast<float>(pageWidth), static_cast<float>(rect.y + height) / static_cast<float>(pageHeight));
+            icon.packed = true;
+
+            if (_compiledPages[pageIndex]) pages[pageIndex]->dirty(VkRect2D{{rect.x, rect.y}, {width, height}});
+
+            _pendingImages[rect.id] = {};
+        }
+        rects.erase(itr, rects.end());
+
+        ++pageIndex;
+    }
+}
+
+void IconAtlas::compile(vsg::Context& context)
+{
+    pack();
+
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        pages[i]->compile(context);
+        _compiledPages[i] = true;
+    }
+}
+
+ImTextureID IconAtlas::id(uint32_t index, uint32_t deviceID) const
+{
+    if (index >= _icons.size() || !_icons[index].packed) return ImTextureID{};
+
+    // a page added by a pack() after compile(..) is only compiled by the next compile(..)
+    auto page = _icons[index].page;
+    if (!_compiledPages[page]) return ImTextureID{};
+
+    return pages[page]->id(deviceID);
+}
+
+void IconAtlas::image(uint32_t index, uint32_t deviceID, const ImVec2& size) const
+{
+    auto textureID = id(index, deviceID);
+    if (!textureID) return;
+
+    auto& icon = _icons[index];
+    ImGui::Image(textureID, (size.x > 0.0f && size.y > 0.0f) ? size : icon.size, icon.uv0, icon.uv1);
+}
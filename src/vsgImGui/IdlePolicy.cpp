@@ -0,0 +1,64 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/IdlePolicy.h>
+#include <vsgImGui/imgui.h>
+
+using namespace vsgImGui;
+
+IdlePolicy::IdlePolicy(uint32_t in_framesAfterActivity) :
+    framesAfterActivity(in_framesAfterActivity),
+    _framesRemaining(in_framesAfterActivity)
+{
+}
+
+IdlePolicy::~IdlePolicy()
+{
+}
+
+void IdlePolicy::requestRedraw(uint32_t numFrames)
+{
+    uint32_t current = _framesRemaining.load();
+    while (current < numFrames && !_framesRemaining.compare_exchange_weak(current, numFrames))
+    {
+    }
+}
+
+bool IdlePolicy::update()
+{
+    if (redrawWhileTextInput && ImGui::GetCurrentContext() && ImGui::GetIO().WantTextInput) requestRedraw(1);
+
+    uint32_t current = _framesRemaining.load();
+    while (current > 0 && !_framesRemaining.compare_exchange_weak(current, current - 1))
+    {
+    }
+
+    if (current > 0)
+    {
+        ++_numUpdatedFrames;
+        return true;
+    }
+
+    ++_numSkippedFrames;
+    return false;
+}
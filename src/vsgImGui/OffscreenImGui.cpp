@@ -0,0 +1,414 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/OffscreenImGui.h>
+
+#include <vsg/io/Logger.h>
+#include <vsg/state/ColorBlendState.h>
+#include <vsg/state/DepthStencilState.h>
+#include <vsg/state/DynamicState.h>
+#include <vsg/state/InputAssemblyState.h>
+#include <vsg/state/MultisampleState.h>
+#include <vsg/state/RasterizationState.h>
+#include <vsg/state/VertexInputState.h>
+#include <vsg/state/ViewportState.h>
+#include <vsg/vk/State.h>
+
+using namespace vsgImGui;
+
+namespace
+{
+    // embedded as SPIR-V like the DrawDataRenderer's shaders, with the GLSL kept as the ShaderModule's source.
+    // A full screen triangle is generated from gl_VertexIndex, so no vertex buffers are required
+    const char* composite_vert = R"(
+#version 450
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+void main()
+{
+    vec2 position = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+    const uint32_t composite_vert_spv[] = {
+        0x07230203, 0x00010000, 0x00000000, 0x0000001d, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+        0x00000000, 0x00000001, 0x0007000f, 0x00000000, 0x00000010, 0x6e69616d, 0x00000000, 0x00000008,
+        0x0000000a, 0x00040047, 0x00000008, 0x0000000b, 0x0000002a, 0x00040047, 0x0000000a, 0x0000000b,
+        0x00000000, 0x00020013, 0x00000001, 0x00030021, 0x00000002, 0x00000001, 0x00030016, 0x00000003,
+        0x00000020, 0x00040017, 0x00000005, 0x00000003, 0x00000004, 0x00040015, 0x00000006, 0x00000020,
+        0x00000001, 0x00040020, 0x00000007, 0x00000001, 0x00000006, 0x0004003b, 0x00000007, 0x00000008,
+        0x00000001, 0x00040020, 0x00000009, 0x00000003, 0x00000005, 0x0004003b, 0x00000009, 0x0000000a,
+        0x00000003, 0x0004002b, 0x00000006, 0x0000000b, 0x00000001, 0x0004002b, 0x00000006, 0x0000000c,
+        0x00000002, 0x0004002b, 0x00000003, 0x0000000d, 0x40000000, 0x0004002b, 0x00000003, 0x0000000e,
+        0x3f800000, 0x0004002b, 0x00000003, 0x0000000f, 0x00000000, 0x00050036, 0x00000001, 0x00000010,
+        0x00000000, 0x00000002, 0x000200f8, 0x00000011, 0x0004003d, 0x00000006, 0x00000012, 0x00000008,
+        0x000500c4, 0x00000006, 0x00000013, 0x00000012, 0x0000000b, 0x000500c7, 0x00000006, 0x00000014,
+        0x00000013, 0x0000000c, 0x000500c7, 0x00000006, 0x00000015, 0x00000012, 0x0000000c, 0x0004006f,
+        0x00000003, 0x00000016, 0x00000014, 0x0004006f, 0x00000003, 0x00000017, 0x00000015, 0x00050085,
+        0x00000003, 0x00000018, 0x00000016, 0x0000000d, 0x00050083, 0x00000003, 0x00000019, 0x00000018,
+        0x0000000e, 0x00050085, 0x00000003, 0x0000001a, 0x00000017, 0x0000000d, 0x00050083, 0x00000003,
+        0x0000001b, 0x0000001a, 0x0000000e, 0x00070050, 0x00000005, 0x0000001c, 0x00000019, 0x0000001b,
+        0x0000000f, 0x0000000e, 0x0003003e, 0x0000000a, 0x0000001c, 0x000100fd, 0x00010038};
+
+    // the offscreen image matches the window size so fetch texels directly rather than filtering
+    const char* composite_frag = R"(
+#version 450
+layout(set = 0, binding = 0) uniform sampler2D uiImage;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    outColor = texelFetch(uiImage, ivec2(gl_FragCoord.xy), 0);
+}
+)";
+
+    const uint32_t composite_frag_spv[] = {
+        0x07230203, 0x00010000, 0x00000000, 0x00000019, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+        0x00000000, 0x00000001, 0x0007000f, 0x00000004, 0x00000011, 0x6e69616d, 0x00000000, 0x0000000d,
+        0x0000000f, 0x00030010, 0x00000011, 0x00000007, 0x00040047, 0x0000000b, 0x00000022, 0x00000000,
+        0x00040047, 0x0000000b, 0x00000021, 0x00000000, 0x00040047, 0x0000000d, 0x0000000b, 0x0000000f,
+        0x00040047, 0x0000000f, 0x0000001e, 0x00000000, 0x00020013, 0x00000001, 0x00030021, 0x00000002,
+        0x00000001, 0x00030016, 0x00000003, 0x00000020, 0x00040017, 0x00000004, 0x00000003, 0x00000004,
+        0x00040015, 0x00000005, 0x00000020, 0x00000001, 0x00040017, 0x00000006, 0x00000005, 0x00000002,
+        0x00040017, 0x00000007, 0x00000003, 0x00000002, 0x00090019, 0x00000008, 0x00000003, 0x00000001,
+        0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x0003001b, 0x00000009, 0x00000008,
+        0x00040020, 0x0000000a, 0x00000000, 0x00000009, 0x0004003b, 0x0000000a, 0x0000000b, 0x00000000,
+        0x00040020, 0x0000000c, 0x00000001, 0x00000004, 0x0004003b, 0x0000000c, 0x0000000d, 0x00000001,
+        0x00040020, 0x0000000e, 0x00000003, 0x00000004, 0x0004003b, 0x0000000e, 0x0000000f, 0x00000003,
+        0x0004002b, 0x00000005, 0x00000010, 0x00000000, 0x00050036, 0x00000001, 0x00000011, 0x00000000,
+        0x00000002, 0x000200f8, 0x00000012, 0x0004003d, 0x00000004, 0x00000013, 0x0000000d, 0x0007004f,
+        0x00000007, 0x00000014, 0x00000013, 0x00000013, 0x00000000, 0x00000001, 0x0004006e, 0x00000006,
+        0x00000015, 0x00000014, 0x0004003d, 0x00000009, 0x00000016, 0x0000000b, 0x00040064, 0x00000008,
+        0x00000017, 0x00000016, 0x0007005f, 0x00000004, 0x00000018, 0x00000017, 0x00000015, 0x00000002,
+        0x00000010, 0x0003003e, 0x0000000f, 0x00000018, 0x000100fd, 0x00010038};
+
+    template<size_t N>
+    vsg::ref_ptr<vsg::ShaderStage> createShaderStage(VkShaderStageFlagBits stage, const char* source, const uint32_t (&code)[N])
+    {
+        auto shaderModule = vsg::ShaderModule::create(std::string(source), vsg::ShaderModule::SPIRV(code, code + N));
+        return vsg::ShaderStage::create(stage, "main", shaderModule);
+    }
+
+    class RecordImGui : public vsg::Inherit<vsg::Node, RecordImGui>
+    {
+    public:
+        explicit RecordImGui(vsg::ref_ptr<RenderImGui> in_renderImGui) :
+            renderImGui(in_renderImGui) {}
+
+        vsg::ref_ptr<RenderImGui> renderImGui;
+
+        void accept(vsg::RecordTraversal& rt) const override
+        {
+            // the UI has already been built for the frame by OffscreenImGui::accept(..), so this just records it
+            renderImGui->accept(rt);
+        }
+    };
+} // namespace
+
+OffscreenImGui::OffscreenImGui(const vsg::ref_ptr<vsg::Window>& window, VkFormat format) :
+    _window(window),
+    _format(format)
+{
+    _device = window->getOrCreateDevice();
+    auto physicalDevice = _device->getPhysicalDevice();
+
+    uint32_t queueFamily = 0;
+    std::tie(queueFamily, std::ignore) = physicalDevice->getQueueFamily(window->traits()->queueFlags, window->getSurface());
+
+    if (_format == VK_FORMAT_UNDEFINED) _format = window->surfaceFormat().format;
+
+    // the image is cleared each time it's rendered and left ready for sampling by the composite pass
+    vsg::AttachmentDescription colorAttachment = {};
+    colorAttachment.format = _format;
+    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    vsg::AttachmentReference colorReference = {};
+    colorReference.attachment = 0;
+    colorReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    vsg::SubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachments.push_back(colorReference);
+
+    // the image is shared by all frames in flight, so the write has to wait for earlier composites to finish reading it
+    vsg::SubpassDependency beforeRender = {};
+    beforeRender.srcSubpass = VK_SUBPASS_EXTERNAL;
+    beforeRender.dstSubpass = 0;
+    beforeRender.srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    beforeRender.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    beforeRender.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    beforeRender.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    beforeRender.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+    vsg::SubpassDependency afterRender = {};
+    afterRender.srcSubpass = 0;
+    afterRender.dstSubpass = VK_SUBPASS_EXTERNAL;
+    afterRender.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    afterRender.dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    afterRender.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    afterRender.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    afterRender.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+    _renderPass = vsg::RenderPass::create(_device, vsg::RenderPass::Attachments{colorAttachment}, vsg::RenderPass::Subpasses{subpass}, vsg::RenderPass::Dependencies{beforeRender, afterRender});
+
+    uint32_t imageCount = std::max(static_cast<uint32_t>(window->numFrames()), 3u);
+    _numFramesInFlight = imageCount;
+    renderImGui = RenderImGui::create(_device, queueFamily, _renderPass, imageCount, imageCount, window->extent2D(), false);
+
+    _context = vsg::Context::create(_device);
+
+    _renderGraph = vsg::RenderGraph::create();
+    _renderGraph->clearValues = {VkClearValue{}}; // transparent black, so the composite leaves the scene untouched where there is no UI
+    _renderGraph->addChild(RecordImGui::create(renderImGui));
+
+    _sampler = vsg::Sampler::create();
+    _sampler->minFilter = VK_FILTER_NEAREST;
+    _sampler->magFilter = VK_FILTER_NEAREST;
+    _sampler->mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    _sampler->addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    _sampler->addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    _sampler->addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    _sampler->maxLod = 0.0f;
+
+    // the composite pipeline shares the DrawDataRenderer's layout, so both can be bound with the same descriptor sets and push constants
+    auto renderer = renderImGui->getRenderer();
+    auto windowRenderPass = window->getOrCreateRenderPass();
+
+    _compositeContext = vsg::Context::create(_device);
+    _compositeContext->renderPass = windowRenderPass;
+
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+    for (auto& attachment : windowRenderPass->attachments)
+    {
+        if (attachment.samples > samples) samples = attachment.samples;
+    }
+
+    auto rasterizationState = vsg::RasterizationState::create();
+    rasterizationState->cullMode = VK_CULL_MODE_NONE;
+
+    // the offscreen image holds premultiplied alpha, as the UI has been blended over transparent black
+    VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
+    colorBlendAttachment.blendEnable = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    auto colorBlendState = vsg::ColorBlendState::create();
+    colorBlendState->attachments = vsg::ColorBlendState::ColorBlendAttachments{colorBlendAttachment};
+
+    auto depthStencilState = vsg::DepthStencilState::create();
+    depthStencilState->depthTestEnable = VK_FALSE;
+    depthStencilState->depthWriteEnable = VK_FALSE;
+
+    auto dynamicState = vsg::DynamicState::create();
+    dynamicState->dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    vsg::ShaderStages shaderStages{
+        createShaderStage(VK_SHADER_STAGE_VERTEX_BIT, composite_vert, composite_vert_spv),
+        createShaderStage(VK_SHADER_STAGE_FRAGMENT_BIT, composite_frag, composite_frag_spv)};
+
+    vsg::GraphicsPipelineStates pipelineStates{
+        vsg::VertexInputState::create(),
+        vsg::InputAssemblyState::create(),
+        rasterizationState,
+        vsg::MultisampleState::create(samples),
+        colorBlendState,
+        depthStencilState,
+        vsg::ViewportState::create(0, 0, 1, 1),
+        dynamicState};
+
+    auto graphicsPipeline = vsg::GraphicsPipeline::create(renderer->pipelineLayout, shaderStages, pipelineStates);
+    _bindCompositePipeline = BindCachedGraphicsPipeline::create(graphicsPipeline);
+}
+
+OffscreenImGui::~OffscreenImGui()
+{
+    for (auto& retired : _retired)
+    {
+        if (retired.descriptorSet) renderImGui->getDescriptorPools()->free(retired.descriptorSet);
+    }
+    if (_descriptorSet) renderImGui->getDescriptorPools()->free(_descriptorSet);
+}
+
+vsg::ref_ptr<CompositeImGui> OffscreenImGui::createComposite()
+{
+    return CompositeImGui::create(vsg::ref_ptr<OffscreenImGui>(this));
+}
+
+void OffscreenImGui::traverse(vsg::Visitor& visitor)
+{
+    renderImGui->accept(visitor);
+}
+
+void OffscreenImGui::traverse(vsg::ConstVisitor& visitor) const
+{
+    renderImGui->accept(visitor);
+}
+
+void OffscreenImGui::_releaseRetired(uint64_t frameCount) const
+{
+    while (!_retired.empty() && (frameCount - _retired.front().frameCount) >= _numFramesInFlight)
+    {
+        if (_retired.front().descriptorSet) renderImGui->getDescriptorPools()->free(_retired.front().descriptorSet);
+        _retired.pop_front();
+    }
+}
+
+void OffscreenImGui::_resize(const VkExtent2D& extent, uint64_t frameCount) const
+{
+    // the frames in flight may still be using the image, so rather than waiting for them keep it, along with the framebuffer and the descriptor set
+    // that reference it, until they have completed. A descriptor set can't be updated while in use, so a new one is allocated for the new image
+    if (_imageView)
+    {
+        _retired.push_back(Retired{frameCount, _imageView, _renderGraph->framebuffer, _descriptorSet});
+        _descriptorSet = VK_NULL_HANDLE;
+    }
+
+    auto image = vsg::Image::create();
+    image->imageType = VK_IMAGE_TYPE_2D;
+    image->format = _format;
+    image->extent = VkExtent3D{extent.width, extent.height, 1};
+    image->mipLevels = 1;
+    image->arrayLayers = 1;
+    image->samples = VK_SAMPLE_COUNT_1_BIT;
+    image->tiling = VK_IMAGE_TILING_OPTIMAL;
+    image->usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    image->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    image->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    _imageView = vsg::createImageView(*_context, image, VK_IMAGE_ASPECT_COLOR_BIT);
+    _sampler->compile(*_context);
+
+    _renderGraph->framebuffer = vsg::Framebuffer::create(_renderPass, vsg::ImageViews{_imageView}, extent.width, extent.height, 1);
+    _renderGraph->renderArea.offset = {0, 0};
+    _renderGraph->renderArea.extent = extent;
+
+    auto renderer = renderImGui->getRenderer();
+    auto deviceID = _device->deviceID;
+    if (!_descriptorSet)
+    {
+        renderer->descriptorSetLayout->compile(*_context);
+        _descriptorSet = renderImGui->getDescriptorPools()->allocate(renderer->descriptorSetLayout->vk(deviceID));
+    }
+
+    if (_descriptorSet)
+    {
+        VkDescriptorImageInfo descriptorImageInfo = {};
+        descriptorImageInfo.sampler = _sampler->vk(deviceID);
+        descriptorImageInfo.imageView = _imageView->vk(deviceID);
+        descriptorImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet write = {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = _descriptorSet;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &descriptorImageInfo;
+        vkUpdateDescriptorSets(*_device, 1, &write, 0, nullptr);
+    }
+
+    _extent = extent;
+    _imageValid = false;
+}
+
+void OffscreenImGui::accept(vsg::RecordTraversal& rt) const
+{
+    auto& commandBuffer = *(rt.getState()->_commandBuffer);
+    if (_device.get() != commandBuffer.getDevice()) return;
+
+    auto frameCount = rt.getFrameStamp() ? rt.getFrameStamp()->frameCount : 0;
+    _releaseRetired(frameCount);
+
+    auto extent = _window->extent2D();
+    if (extent.width == 0 || extent.height == 0) return;
+    if (extent.width != _extent.width || extent.height != _extent.height) _resize(extent, frameCount);
+
+    // on idle frames, as determined by the RenderImGui's IdlePolicy, the UI isn't rebuilt and the offscreen image is reused.
+    // Built through the RenderImGui so its per frame bookkeeping and any build thread are honoured
+    auto builtFrame = renderImGui->buildFrame(rt);
+    _stats.hasIdlePolicy = renderImGui->idlePolicy.valid();
+
+    // the ImDrawData can be rebuilt without any visible change, every frame when there isn't an IdlePolicy, so compare its contents
+    bool dirty = !_imageValid || builtFrame.fingerprint != _fingerprint;
+    if (builtFrame.rebuilt && !dirty) ++_stats.numUnchangedFrames;
+    _fingerprint = builtFrame.fingerprint;
+
+    if (!dirty)
+    {
+        ++_stats.numSkippedFrames;
+        return;
+    }
+
+    _renderGraph->accept(rt);
+
+    _imageValid = true;
+    ++_stats.numRenderedFrames;
+}
+
+void OffscreenImGui::composite(vsg::RecordTraversal& rt) const
+{
+    auto& state = *rt.getState();
+    auto& commandBuffer = *(state._commandBuffer);
+    if (_device.get() != commandBuffer.getDevice() || !_imageValid || !_descriptorSet) return;
+
+    auto deviceID = commandBuffer.deviceID;
+    if (!_bindCompositePipeline->vk(deviceID) && !_bindCompositePipeline->failed(deviceID))
+    {
+        _bindCompositePipeline->pipelineCache = renderImGui->getRenderer()->bindGraphicsPipeline->pipelineCache;
+        _bindCompositePipeline->compile(*_compositeContext);
+    }
+    if (!_bindCompositePipeline->vk(deviceID)) return;
+
+    state.push(_bindCompositePipeline);
+    state.dirty = true;
+    state.record();
+
+    VkViewport viewport{0.0f, 0.0f, static_cast<float>(_extent.width), static_cast<float>(_extent.height), 0.0f, 1.0f};
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{{0, 0}, _extent};
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, renderImGui->getRenderer()->pipelineLayout->vk(deviceID), 0, 1, &_descriptorSet, 0, nullptr);
+    vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+
+    state.pop(_bindCompositePipeline);
+
+    // descriptor sets have been bound directly so make sure any subsequent scene graph state gets re-applied
+    for (auto& stateStack : state.stateStacks) stateStack.dirty = true;
+    state.dirty = true;
+}
@@ -0,0 +1,122 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/PerformanceOverlay.h>
+#include <vsgImGui/implot.h>
+
+#include <vsg/app/RecordTraversal.h>
+
+#include <algorithm>
+#include <chrono>
+
+using namespace vsgImGui;
+
+PerformanceOverlay::PerformanceOverlay(vsg::ref_ptr<RenderImGui> in_renderImGui, uint32_t in_numSamples) :
+    renderImGui(in_renderImGui),
+    _frameTimes(std::max(in_numSamples, 2u), 0.0f),
+    _drawCalls(std::max(in_numSamples, 2u), 0.0f),
+    _gpuTimes(std::max(in_numSamples, 2u), 0.0f)
+{
+}
+
+PerformanceOverlay::~PerformanceOverlay()
+{
+}
+
+void PerformanceOverlay::accept(vsg::RecordTraversal& rt) const
+{
+    auto frameStamp = rt.getFrameStamp();
+    if (!frameStamp) return;
+
+    float frameTime = 0.0f;
+    if (_previousTime) frameTime = std::chrono::duration<float, std::milli>(frameStamp->time - *_previousTime).count();
+    _previousTime = frameStamp->time;
+
+    auto render = renderImGui.ref_ptr();
+    DrawDataRenderer::RecordStats recordStats;
+    DrawDataRenderer::TimingStats timingStats;
+    if (render)
+    {
+        recordStats = render->getRenderer()->getRecordStats();
+        timingStats = render->getTimingStats();
+    }
+
+    int numSamples = static_cast<int>(_frameTimes.size());
+    _frameTimes[_offset] = frameTime;
+    _drawCalls[_offset] = static_cast<float>(recordStats.numDrawCalls);
+    _gpuTimes[_offset] = static_cast<float>(timingStats.gpuTime.average);
+    _offset = (_offset + 1) % numSamples;
+    _count = std::min(_count + 1, numSamples);
+
+    if (!visible) return;
+
+    const float padding = 10.0f;
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImVec2 position((corner & 1) ? (viewport->WorkPos.x + viewport->WorkSize.x - padding) : (viewport->WorkPos.x + padding),
+                    (corner & 2) ? (viewport->WorkPos.y + viewport->WorkSize.y - padding) : (viewport->WorkPos.y + padding));
+    ImVec2 pivot((corner & 1) ? 1.0f : 0.0f, (corner & 2) ? 1.0f : 0.0f);
+    ImGui::SetNextWindowPos(position, ImGuiCond_Always, pivot);
+    ImGui::SetNextWindowBgAlpha(0.35f);
+
+    ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings |
+                                   ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove;
+    if (ImGui::Begin("vsgImGui::PerformanceOverlay", nullptr, windowFlags))
+    {
+        ImGui::Text("frame %.2f ms, UI draw calls %u", frameTime, recordStats.numDrawCalls);
+
+        // GPU timing is only available once RenderImGui::setupTimestamps(..) has been called and the first queries have completed
+        bool gpuTimed = timingStats.numFrames > 0;
+        if (gpuTimed)
+        {
+            ImGui::Text("UI GPU %.3f ms (min %.3f, max %.3f)", timingStats.gpuTime.average, timingStats.gpuTime.min, timingStats.gpuTime.max);
+        }
+
+        // the ring buffers are plotted in place, offset being the index of the oldest sample
+        int offset = (_count < numSamples) ? 0 : _offset;
+        ImPlotAxisFlags axisFlags = ImPlotAxisFlags_NoTickLabels;
+        if (ImPlot::BeginPlot("##frame time", ImVec2(320.0f, 100.0f), ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect | ImPlotFlags_NoMouseText))
+        {
+            ImPlot::SetupAxes(nullptr, "ms", axisFlags, ImPlotAxisFlags_AutoFit);
+            ImPlot::SetupAxisLimits(ImAxis_X1, 0.0, static_cast<double>(numSamples), ImGuiCond_Always);
+            ImPlot::PlotLine("frame", _frameTimes.data(), _count, 1.0, 0.0, 0, offset);
+            ImPlot::EndPlot();
+        }
+
+        if (ImPlot::BeginPlot("##draw calls", ImVec2(320.0f, 80.0f), ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect | ImPlotFlags_NoMouseText))
+        {
+            ImPlot::SetupAxes(nullptr, "draws", axisFlags, ImPlotAxisFlags_AutoFit);
+            ImPlot::SetupAxisLimits(ImAxis_X1, 0.0, static_cast<double>(numSamples), ImGuiCond_Always);
+            ImPlot::PlotLine("UI draw calls", _drawCalls.data(), _count, 1.0, 0.0, 0, offset);
+            ImPlot::EndPlot();
+        }
+
+        if (gpuTimed && ImPlot::BeginPlot("##gpu time", ImVec2(320.0f, 80.0f), ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect | ImPlotFlags_NoMouseText))
+        {
+            ImPlot::SetupAxes(nullptr, "GPU ms", axisFlags, ImPlotAxisFlags_AutoFit);
+            ImPlot::SetupAxisLimits(ImAxis_X1, 0.0, static_cast<double>(numSamples), ImGuiCond_Always);
+            ImPlot::PlotLine("UI GPU time", _gpuTimes.data(), _count, 1.0, 0.0, 0, offset);
+            ImPlot::EndPlot();
+        }
+    }
+    ImGui::End();
+}
@@ -0,0 +1,274 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/PipelineCache.h>
+
+#include <vsg/io/Logger.h>
+#include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/Context.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace vsgImGui;
+
+namespace
+{
+    struct PipelineCacheHeader
+    {
+        char magic[8] = {'v', 's', 'g', 'I', 'm', 'G', 'u', 'i'};
+        uint32_t version = 1;
+        uint32_t vendorID = 0;
+        uint32_t deviceID = 0;
+        uint32_t driverVersion = 0;
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE] = {};
+        uint8_t deviceUUID[VK_UUID_SIZE] = {};
+        uint8_t driverUUID[VK_UUID_SIZE] = {};
+        uint64_t dataSize = 0;
+    };
+
+    PipelineCacheHeader createHeader(vsg::PhysicalDevice& physicalDevice)
+    {
+        PipelineCacheHeader header;
+
+        auto& properties = physicalDevice.getProperties();
+        header.vendorID = properties.vendorID;
+        header.deviceID = properties.deviceID;
+        header.driverVersion = properties.driverVersion;
+        std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+        auto idProperties = physicalDevice.getProperties<VkPhysicalDeviceIDProperties, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES>();
+        std::memcpy(header.deviceUUID, idProperties.deviceUUID, VK_UUID_SIZE);
+        std::memcpy(header.driverUUID, idProperties.driverUUID, VK_UUID_SIZE);
+
+        return header;
+    }
+
+    bool compatible(const PipelineCacheHeader& lhs, const PipelineCacheHeader& rhs)
+    {
+        return std::memcmp(lhs.magic, rhs.magic, sizeof(lhs.magic)) == 0 &&
+               lhs.version == rhs.version &&
+               lhs.vendorID == rhs.vendorID &&
+               lhs.deviceID == rhs.deviceID &&
+               lhs.driverVersion == rhs.driverVersion &&
+               std::memcmp(lhs.pipelineCacheUUID, rhs.pipelineCacheUUID, VK_UUID_SIZE) == 0 &&
+               std::memcmp(lhs.deviceUUID, rhs.deviceUUID, VK_UUID_SIZE) == 0 &&
+               std::memcmp(lhs.driverUUID, rhs.driverUUID, VK_UUID_SIZE) == 0;
+    }
+} // namespace
+
+PipelineCache::PipelineCache(vsg::ref_ptr<vsg::Device> in_device, const vsg::Path& in_filename) :
+    device(in_device),
+    filename(in_filename)
+{
+    auto initialData = _read();
+
+    VkPipelineCacheCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize = initialData.size();
+    createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+    if (VkResult result = vkCreatePipelineCache(*device, &createInfo, device->getAllocationCallbacks(), &_pipelineCache); result != VK_SUCCESS)
+    {
+        vsg::warn("vsgImGui::PipelineCache unable to create VkPipelineCache, result = ", result);
+        _pipelineCache = VK_NULL_HANDLE;
+    }
+}
+
+PipelineCache::~PipelineCache()
+{
+    if (_pipelineCache) vkDestroyPipelineCache(*device, _pipelineCache, device->getAllocationCallbacks());
+}
+
+std::vector<uint8_t> PipelineCache::_read() const
+{
+    if (filename.empty()) return {};
+
+    std::ifstream fin(filename.string(), std::ios::in | std::ios::binary);
+    if (!fin) return {};
+
+    PipelineCacheHeader header;
+    if (!fin.read(reinterpret_cast<char*>(&header), sizeof(header))) return {};
+
+    if (!compatible(header, createHeader(*(device->getPhysicalDevice()))))
+    {
+        vsg::info("vsgImGui::PipelineCache ignoring ", filename, " as it was written for a different device or driver.");
+        return {};
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(header.dataSize));
+    if (!fin.read(reinterpret_cast<char*>(data.data()), data.size()))
+    {
+        vsg::warn("vsgImGui::PipelineCache ignoring truncated ", filename);
+        return {};
+    }
+
+    return data;
+}
+
+bool PipelineCache::write() const
+{
+    if (filename.empty() || !_pipelineCache) return false;
+
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(*device, _pipelineCache, &dataSize, nullptr) != VK_SUCCESS) return false;
+
+    std::vector<uint8_t> data(dataSize);
+    if (vkGetPipelineCacheData(*device, _pipelineCache, &dataSize, data.data()) != VK_SUCCESS) return false;
+
+    auto header = createHeader(*(device->getPhysicalDevice()));
+    header.dataSize = dataSize;
+
+    // write to a temporary file alongside filename and rename it into place, so a crash or another RenderImGui writing the same
+    // cache at the same time can't leave a truncated or interleaved file behind, the last complete write wins.
+    std::filesystem::path path(filename.string());
+    std::filesystem::path tempPath(path.string() + ".tmp" + std::to_string(std::random_device{}()));
+    {
+        std::ofstream fout(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!fout)
+        {
+            vsg::warn("vsgImGui::PipelineCache unable to write ", filename);
+            return false;
+        }
+
+        fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        fout.write(reinterpret_cast<const char*>(data.data()), dataSize);
+        fout.close();
+        if (!fout)
+        {
+            vsg::warn("vsgImGui::PipelineCache unable to write ", filename);
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec)
+    {
+        vsg::warn("vsgImGui::PipelineCache unable to replace ", filename, ", ", ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+BindCachedGraphicsPipeline::BindCachedGraphicsPipeline(vsg::ref_ptr<vsg::GraphicsPipeline> in_pipeline, vsg::ref_ptr<PipelineCache> in_pipelineCache) :
+    Inherit(0), // slot 0
+    pipeline(in_pipeline),
+    pipelineCache(in_pipelineCache)
+{
+}
+
+BindCachedGraphicsPipeline::~BindCachedGraphicsPipeline()
+{
+    release();
+}
+
+void BindCachedGraphicsPipeline::compile(vsg::Context& context)
+{
+    if (!pipeline || !pipeline->layout) return;
+
+    auto deviceID = context.deviceID;
+    if (_implementation.size() <= deviceID) _implementation.resize(deviceID + 1);
+
+    auto& implementation = _implementation[deviceID];
+    if (implementation.pipeline || implementation.failed) return;
+
+    auto& stages = pipeline->stages;
+
+    // the vsgImGui shaders are all embedded as SPIR-V, so there's no dependency on VSG being built with glslang
+    for (auto& shaderStage : stages)
+    {
+        if (!shaderStage->module || shaderStage->module->code.empty())
+        {
+            vsg::warn("vsgImGui::BindCachedGraphicsPipeline requires shaders compiled to SPIR-V.");
+            implementation.failed = true;
+            return;
+        }
+    }
+
+    pipeline->layout->compile(context);
+
+    std::vector<VkPipelineShaderStageCreateInfo> shaderStageCreateInfo(stages.size());
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+        stages[i]->compile(context);
+
+        shaderStageCreateInfo[i].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStageCreateInfo[i].pNext = nullptr;
+        stages[i]->apply(context, shaderStageCreateInfo[i]);
+    }
+
+    VkGraphicsPipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.layout = pipeline->layout->vk(deviceID);
+    pipelineInfo.renderPass = *context.renderPass;
+    pipelineInfo.subpass = pipeline->subpass;
+    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+    pipelineInfo.stageCount = static_cast<uint32_t>(shaderStageCreateInfo.size());
+    pipelineInfo.pStages = shaderStageCreateInfo.data();
+
+    for (auto& pipelineState : pipeline->pipelineStates)
+    {
+        pipelineState->apply(context, pipelineInfo);
+    }
+
+    VkPipelineCache vk_pipelineCache = (pipelineCache && pipelineCache->device == context.device) ? pipelineCache->vk() : VK_NULL_HANDLE;
+
+    auto device = context.device;
+    if (VkResult result = vkCreateGraphicsPipelines(*device, vk_pipelineCache, 1, &pipelineInfo, device->getAllocationCallbacks(), &implementation.pipeline); result == VK_SUCCESS)
+    {
+        implementation.device = device;
+    }
+    else
+    {
+        vsg::warn("vsgImGui::BindCachedGraphicsPipeline failed to create graphics pipeline, result = ", result);
+        implementation.pipeline = VK_NULL_HANDLE;
+        implementation.failed = true;
+    }
+
+    context.scratchMemory->release();
+}
+
+void BindCachedGraphicsPipeline::record(vsg::CommandBuffer& commandBuffer) const
+{
+    VkPipeline vk_pipeline = vk(commandBuffer.deviceID);
+    if (vk_pipeline == VK_NULL_HANDLE) return;
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vk_pipeline);
+    commandBuffer.setCurrentPipelineLayout(pipeline->layout);
+}
+
+void BindCachedGraphicsPipeline::release()
+{
+    for (auto& implementation : _implementation)
+    {
+        if (implementation.pipeline) vkDestroyPipeline(*implementation.device, implementation.pipeline, implementation.device->getAllocationCallbacks());
+    }
+    _implementation.clear();
+}
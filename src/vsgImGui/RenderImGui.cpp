@@ -21,28 +21,31 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 </editor-fold> */
 
+#include <vsgImGui/PerformanceOverlay.h>
 #include <vsgImGui/RenderImGui.h>
+#include <vsgImGui/Texture.h>
+#include <vsgImGui/imgui_internal.h>
 #include <vsgImGui/implot.h>
 
-#include "../imgui/backends/imgui_impl_vulkan.h"
-
 #include <vsg/io/Logger.h>
 #include <vsg/maths/color.h>
+#include <vsg/app/CompileTraversal.h>
+#include <vsg/app/RecordTraversal.h>
+#include <vsg/state/DescriptorImage.h>
 #include <vsg/utils/CoordinateSpace.h>
+#include <vsg/vk/Fence.h>
 #include <vsg/vk/State.h>
-#include <vsg/vk/SubmitCommands.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
 
 using namespace vsgImGui;
 
 namespace vsgImGui
 {
-    void check_vk_result(VkResult err)
-    {
-        if (err == 0) return;
-
-        vsg::error("[vulkan] Error: VkResult = ", err);
-    }
-
     class ImGuiNode : public vsg::Inherit<vsg::Node, ImGuiNode>
     {
     public:
@@ -68,34 +71,226 @@ namespace vsgImGui
 
 } // namespace vsgImGui
 
+struct RenderImGui::BuildThread
+{
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool requested = false;
+    bool glyphsAdded = false; // set by the record thread when FontAtlas::update(..) has added glyphs, so the next build isn't skipped as idle
+    bool stop = false;
+    vsg::ref_ptr<vsg::FrameStamp> frameStamp;
+    vsg::ref_ptr<DrawDataSnapshot> snapshot;
+    vsg::ref_ptr<vsg::RecordTraversal> traversal;
+};
+
+struct RenderImGui::ChildTimings
+{
+    // written by the thread building the UI and read by getChildTimings() without locking, the mutex only guards changes to the list of rings
+    struct Ring
+    {
+        explicit Ring(size_t size) :
+            samples(size) {}
+
+        const vsg::Node* node = nullptr;
+        std::string name;
+        std::vector<std::atomic<float>> samples;
+        std::atomic<uint64_t> count{0};
+    };
+
+    explicit ChildTimings(uint32_t in_windowSize) :
+        windowSize(in_windowSize) {}
+
+    size_t windowSize;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+};
+
 RenderImGui::RenderImGui(const vsg::ref_ptr<vsg::Window>& window, bool useClearAttachments)
 {
-    _init(window, useClearAttachments);
-    _uploadFonts();
+    _init(window, useClearAttachments, {});
+}
+
+RenderImGui::RenderImGui(const vsg::ref_ptr<vsg::Window>& window, vsg::ref_ptr<FontAtlas> sharedFontAtlas, bool useClearAttachments)
+{
+    _init(window, useClearAttachments, sharedFontAtlas);
 }
 
 RenderImGui::RenderImGui(vsg::ref_ptr<vsg::Device> device, uint32_t queueFamily,
                          vsg::ref_ptr<vsg::RenderPass> renderPass,
                          uint32_t minImageCount, uint32_t imageCount,
-                         VkExtent2D imageSize, bool useClearAttachments)
+                         VkExtent2D imageSize, bool useClearAttachments,
+                         vsg::ref_ptr<FontAtlas> sharedFontAtlas)
 {
-    _init(device, queueFamily, renderPass, minImageCount, imageCount, imageSize, useClearAttachments);
-    _uploadFonts();
+    _init(device, queueFamily, renderPass, minImageCount, imageCount, imageSize, useClearAttachments, sharedFontAtlas);
 }
 
 RenderImGui::~RenderImGui()
 {
-    ImGui_ImplVulkan_Shutdown();
-    ImPlot::DestroyContext();
-    ImGui::DestroyContext();
+    stopBuildThread();
+
+    if (auto& pipelineCache = _renderer->bindGraphicsPipeline->pipelineCache; pipelineCache && !pipelineCache->filename.empty()) pipelineCache->write();
+
+    {
+        // DestroyContext() temporarily makes the context current
+        std::scoped_lock<std::recursive_mutex> lock(_contextMutex);
+        if (_implotContext) ImPlot::DestroyContext(_implotContext);
+        if (_imguiContext) ImGui::DestroyContext(_imguiContext);
+    }
+
+    // the ImFontAtlas is owned by the FontAtlas, which may be shared with other RenderImGui, so release it after the contexts
+    _fontAtlas = {};
+}
+
+ImGuiContext*& vsgImGui::currentImGuiContext()
+{
+    thread_local ImGuiContext* s_context = nullptr;
+    return s_context;
+}
+
+ImPlotContext*& vsgImGui::currentImPlotContext()
+{
+    thread_local ImPlotContext* s_context = nullptr;
+    return s_context;
+}
+
+void RenderImGui::makeCurrent() const
+{
+    ImGui::SetCurrentContext(_imguiContext);
+    ImPlot::SetCurrentContext(_implotContext);
+}
+
+RenderImGui::ContextScope::ContextScope(const RenderImGui* renderImGui) :
+    _previousImGuiContext(ImGui::GetCurrentContext()),
+    _previousImPlotContext(ImPlot::GetCurrentContext())
+{
+    if (!renderImGui) return;
+
+    _lock = std::unique_lock<std::recursive_mutex>(renderImGui->_contextMutex);
+    renderImGui->makeCurrent();
+}
+
+RenderImGui::ContextScope::~ContextScope()
+{
+    if (!_lock) return;
+
+    ImGui::SetCurrentContext(_previousImGuiContext);
+    ImPlot::SetCurrentContext(_previousImPlotContext);
+}
+
+void RenderImGui::setPipelineCache(vsg::ref_ptr<PipelineCache> pipelineCache)
+{
+    _renderer->bindGraphicsPipeline->pipelineCache = pipelineCache;
+}
+
+void RenderImGui::setPipelineCache(const vsg::Path& filename)
+{
+    setPipelineCache(PipelineCache::create(_device, filename));
+}
+
+void RenderImGui::add(const LegacyFunction& legacyFunc, const std::string& name)
+{
+    auto node = ImGuiNode::create(legacyFunc);
+    if (!name.empty()) node->setValue("name", name);
+    addChild(node);
+}
+
+void RenderImGui::setupChildTiming(uint32_t windowSize)
+{
+    if (_childTimings || windowSize == 0) return;
+
+    _childTimings = std::make_unique<ChildTimings>(windowSize);
+}
+
+void RenderImGui::_traverseTimed(vsg::RecordTraversal& rt) const
+{
+    auto& timings = *_childTimings;
+
+    // take the ring pointers under the lock, the Rings themselves are only replaced here so remain valid while the children are timed
+    std::vector<ChildTimings::Ring*> rings;
+    {
+        std::scoped_lock<std::mutex> lock(timings.mutex);
+
+        // children rarely change so the rings are only rebuilt when they do
+        bool childrenChanged = timings.rings.size() != children.size();
+        for (size_t i = 0; !childrenChanged && i < children.size(); ++i) childrenChanged = (timings.rings[i]->node != children[i].get());
+        if (childrenChanged)
+        {
+            timings.rings.resize(children.size());
+            for (size_t i = 0; i < children.size(); ++i)
+            {
+                auto& ring = timings.rings[i];
+                if (ring && ring->node == children[i].get()) continue;
+
+                ring = std::make_unique<ChildTimings::Ring>(timings.windowSize);
+                ring->node = children[i].get();
+                if (!children[i]->getValue("name", ring->name)) ring->name = children[i]->className();
+            }
+        }
+
+        rings.reserve(timings.rings.size());
+        for (auto& ring : timings.rings) rings.push_back(ring.get());
+    }
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        if (!_buildable(*children[i], rt)) continue;
+
+        auto start = std::chrono::steady_clock::now();
+        children[i]->accept(rt);
+        auto duration = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        auto& ring = *rings[i];
+        auto count = ring.count.load(std::memory_order_relaxed);
+        ring.samples[count % timings.windowSize].store(duration, std::memory_order_relaxed);
+        ring.count.store(count + 1, std::memory_order_release);
+    }
 }
 
-void RenderImGui::add(const LegacyFunction& legacyFunc)
+std::vector<RenderImGui::ChildTiming> RenderImGui::getChildTimings() const
 {
-    addChild(ImGuiNode::create(legacyFunc));
+    std::vector<ChildTiming> results;
+    if (!_childTimings) return results;
+
+    auto& timings = *_childTimings;
+    std::scoped_lock<std::mutex> lock(timings.mutex);
+
+    std::vector<float> samples;
+    for (size_t i = 0; i < timings.rings.size(); ++i)
+    {
+        auto& ring = *timings.rings[i];
+
+        ChildTiming timing;
+        timing.index = i;
+        timing.name = ring.name;
+        timing.numSamples = ring.count.load(std::memory_order_acquire);
+        if (timing.numSamples > 0)
+        {
+            // samples may be overwritten while they're copied, which only blurs the window slightly
+            size_t numSamples = static_cast<size_t>(std::min<uint64_t>(timing.numSamples, timings.windowSize));
+            samples.resize(numSamples);
+            for (size_t s = 0; s < numSamples; ++s) samples[s] = ring.samples[s].load(std::memory_order_relaxed);
+
+            timing.last = ring.samples[(timing.numSamples - 1) % timings.windowSize].load(std::memory_order_relaxed);
+
+            double total = 0.0;
+            for (auto sample : samples) total += sample;
+            timing.average = total / static_cast<double>(numSamples);
+
+            std::sort(samples.begin(), samples.end());
+            auto percentile = [&samples](double p) { return samples[std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())))]; };
+            timing.p50 = percentile(0.5);
+            timing.p95 = percentile(0.95);
+            timing.p99 = percentile(0.99);
+            timing.max = samples.back();
+        }
+        results.push_back(timing);
+    }
+
+    return results;
 }
 
-void RenderImGui::_init(const vsg::ref_ptr<vsg::Window>& window, bool useClearAttachments)
+void RenderImGui::_init(const vsg::ref_ptr<vsg::Window>& window, bool useClearAttachments, vsg::ref_ptr<FontAtlas> sharedFontAtlas)
 {
     auto device = window->getOrCreateDevice();
     auto physicalDevice = device->getPhysicalDevice();
@@ -119,26 +314,53 @@ void RenderImGui::_init(const vsg::ref_ptr<vsg::Window>& window, bool useClearAt
             capabilities.maxImageCount); // Vulkan spec specifies 0 as being
                                          // unlimited number of images
 
-    _init(device, queueFamily, window->getOrCreateRenderPass(), capabilities.minImageCount, imageCount, window->extent2D(), useClearAttachments);
+    _init(device, queueFamily, window->getOrCreateRenderPass(), capabilities.minImageCount, imageCount, window->extent2D(), useClearAttachments, sharedFontAtlas);
+    _deviceFeatures = window->traits()->deviceFeatures;
 }
 
 void RenderImGui::_init(
     vsg::ref_ptr<vsg::Device> device, uint32_t queueFamily,
     vsg::ref_ptr<vsg::RenderPass> renderPass,
-    uint32_t minImageCount, uint32_t imageCount,
-    VkExtent2D imageSize, bool useClearAttachments)
+    uint32_t /*minImageCount*/, uint32_t imageCount,
+    VkExtent2D imageSize, bool useClearAttachments,
+    vsg::ref_ptr<FontAtlas> sharedFontAtlas)
 {
     IMGUI_CHECKVERSION();
 
-    if (!ImGui::GetCurrentContext())
+    if (sharedFontAtlas && sharedFontAtlas->descriptorPools->device != device)
     {
-        ImGui::CreateContext();
+        vsg::warn("vsgImGui::RenderImGui shared FontAtlas is for a different device, creating a separate font atlas.");
+        sharedFontAtlas = {};
     }
 
+    ImFontAtlas* ownedAtlas = nullptr;
+
+    if (ImGui::GetCurrentContext() && !sharedFontAtlas && !ImGui::GetIO().BackendRendererName)
+    {
+        // adopt a context the application created prior to the RenderImGui, e.g. to set up fonts and styles
+        _imguiContext = ImGui::GetCurrentContext();
+        _implotContext = ImPlot::GetCurrentContext();
+
+        // take over the context's atlas so it remains valid for any RenderImGui sharing it
+        ownedAtlas = ImGui::GetIO().Fonts;
+        _imguiContext->FontAtlasOwnedByContext = false;
+    }
+    else
+    {
+        ownedAtlas = sharedFontAtlas ? nullptr : IM_NEW(ImFontAtlas)();
+        _imguiContext = ImGui::CreateContext(sharedFontAtlas ? sharedFontAtlas->atlas : ownedAtlas);
+    }
+
+    // CreateContext() restores the previous context so make the new one current for the rest of the set up, and for the application's subsequent ImGui calls
+    ImGui::SetCurrentContext(_imguiContext);
+    if (!_implotContext) _implotContext = ImPlot::CreateContext();
+    ImPlot::SetCurrentContext(_implotContext);
+
     bool sRGB = false;
     for (auto& attachment : renderPass->attachments)
     {
-        if (attachment.finalLayout==VK_IMAGE_LAYOUT_PRESENT_SRC_KHR || attachment.finalLayout==VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL)
+        // SHADER_READ_ONLY_OPTIMAL covers offscreen UI layers that are later composited into the window
+        if (attachment.finalLayout==VK_IMAGE_LAYOUT_PRESENT_SRC_KHR || attachment.finalLayout==VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL || attachment.finalLayout==VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
         {
             if (attachment.format == VK_FORMAT_B8G8R8_SRGB ||
                 attachment.format == VK_FORMAT_B8G8R8A8_SRGB ||
@@ -152,59 +374,38 @@ void RenderImGui::_init(
         ImGuiStyle_sRGB_to_linear(ImGui::GetStyle());
     }
 
-    if (!ImPlot::GetCurrentContext()) ImPlot::CreateContext();
-
-    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
-    for (auto& attachment : renderPass->attachments)
-    {
-        if (attachment.samples > samples) samples = attachment.samples;
-    }
-
     // ImGui may change this later, but ensure the display
     // size is set to something, to prevent assertions
     // in ImGui::newFrame.
     ImGuiIO& io = ImGui::GetIO();
     io.DisplaySize.x = static_cast<float>(imageSize.width);
     io.DisplaySize.y = static_cast<float>(imageSize.height);
+    io.BackendRendererName = "vsgImGui";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset; // the DrawDataRenderer honours ImDrawCmd::VtxOffset, allowing for large meshes
 
     _device = device;
     _queueFamily = queueFamily;
     _queue = _device->getQueue(_queueFamily);
 
-    ImGui_ImplVulkan_InitInfo init_info = {};
-    init_info.Instance = *(_device->getInstance());
-    init_info.PhysicalDevice = *(_device->getPhysicalDevice());
-    init_info.Device = *(_device);
-    init_info.QueueFamily = _queueFamily;
-    init_info.Queue = *(_queue); // ImGui doesn't use the queue so we shouldn't need to assign it, but it has an IM_ASSERT requiring it during debug build.
-    init_info.PipelineCache = VK_NULL_HANDLE;
-    init_info.MSAASamples = samples;
-
-    // Create Descriptor Pool
-    vsg::DescriptorPoolSizes pool_sizes = {
-        {VK_DESCRIPTOR_TYPE_SAMPLER, 1000},
-        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1000},
-        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1000},
-        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1000},
-        {VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 1000},
-        {VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 1000},
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1000},
-        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1000},
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1000},
-        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1000},
-        {VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1000}};
-
-    uint32_t maxSets = static_cast<uint32_t>(1000 * pool_sizes.size());
-    _descriptorPool = vsg::DescriptorPool::create(_device, maxSets, pool_sizes);
-
-    init_info.DescriptorPool = *_descriptorPool;
-    init_info.RenderPass = *renderPass;
-    init_info.Allocator = nullptr;
-    init_info.MinImageCount = std::max(minImageCount, 2u); // ImGui's Vulkan backend has an assert that requires MinImageCount to be 2 or more.
-    init_info.ImageCount = imageCount;
-    init_info.CheckVkResultFn = check_vk_result;
-
-    ImGui_ImplVulkan_Init(&init_info);
+    // the UI only needs COMBINED_IMAGE_SAMPLER descriptor sets for ImTextureID, start small and grow on demand
+    _descriptorPools = DescriptorPools::create(_device);
+
+    // context used to compile the UI pipeline and transfer the font atlas
+    _context = vsg::Context::create(_device);
+    _context->renderPass = renderPass;
+    _context->graphicsQueue = _queue;
+    _context->commandPool = vsg::CommandPool::create(_device, _queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+
+    _renderer = DrawDataRenderer::create(*_context, imageCount);
+    if (sharedFontAtlas)
+    {
+        _fontAtlas = sharedFontAtlas;
+    }
+    else
+    {
+        _fontAtlas = FontAtlas::create(io.Fonts, _descriptorPools, _renderer->descriptorSetLayout);
+        _fontAtlas->ownsAtlas = (ownedAtlas != nullptr);
+    }
 
     if (useClearAttachments)
     {
@@ -217,33 +418,510 @@ void RenderImGui::_init(
     }
 }
 
-void RenderImGui::_uploadFonts()
+void RenderImGui::traverse(vsg::Visitor& visitor)
 {
-    ImGui_ImplVulkan_CreateFontsTexture();
+    // visitors don't call ImGui, so the contexts are only made current by the RecordTraversal building the UI, see build(..)
+    // when compiled as part of the scene graph compile the UI pipeline and queue the font atlas transfer with the rest of the scene
+    if (auto compileTraversal = dynamic_cast<vsg::CompileTraversal*>(&visitor))
+    {
+        _renderer->compile(*_context);
+
+        // set up the resources of the additional devices here so the record traversals only have to look them up
+        std::scoped_lock<std::mutex> lock(_devicesMutex);
+        for (auto& resources : _additionalDevices)
+        {
+            if (!resources) continue;
+
+            vsg::Context* context = nullptr;
+            for (auto& compileContext : compileTraversal->contexts)
+            {
+                if (compileContext->device == resources->device) context = compileContext.get();
+            }
+            _compileAdditionalDevice(*resources, context);
+        }
+    }
+
+    _fontAtlas->accept(visitor);
+
+    Group::traverse(visitor);
 }
 
-void RenderImGui::accept(vsg::RecordTraversal& rt) const
+bool RenderImGui::_compile() const
 {
-    auto& commandBuffer = *(rt.getState()->_commandBuffer);
-    if (_device.get() != commandBuffer.getDevice()) return;
+    // fallback for when the RenderImGui hasn't been compiled along with the rest of the scene graph
+    if (!_renderer->compiled(_device->deviceID)) _renderer->compile(*_context);
 
-    // record all the ImGui commands to ImDrawData container
-    ImGui_ImplVulkan_NewFrame();
-    ImGui::NewFrame();
+    if (_fontUploadPending)
+    {
+        // rather than stalling the record traversal the UI isn't built until the transfer has completed
+        if (_context->fence && _context->fence->status() == VK_NOT_READY) return false;
 
-    // traverse children
-    traverse(rt);
+        // the transfer has completed so this doesn't block, it just releases the staging resources
+        _context->waitForCompletion();
+        _fontUploadPending = false;
+    }
+    else if (!_fontAtlas->compiled(_device->deviceID))
+    {
+        vsg::debug("vsgImGui::RenderImGui font atlas not compiled by the viewer, uploading it before the UI is rendered.");
 
-    ImGui::EndFrame();
-    ImGui::Render();
+        _fontAtlas->compile(*_context);
+        _context->record();
+        _fontUploadPending = true;
+        return false;
+    }
+
+    return true;
+}
+
+bool RenderImGui::build(vsg::RecordTraversal& rt) const
+{
+    ContextScope scope(this);
+
+    bool glyphsAdded = false;
+    if (_buildThread && &rt == _buildThread->traversal.get())
+    {
+        // the record thread owns _context, compiling and updating the font atlas before it requests the build, see _recordSnapshot(..)
+        std::scoped_lock<std::mutex> lock(_buildThread->mutex);
+        glyphsAdded = _buildThread->glyphsAdded;
+        _buildThread->glyphsAdded = false;
+    }
+    else
+    {
+        if (!_compile()) return false;
+
+        // returns true once the glyphs requested on an earlier frame have been uploaded, so the frame is rebuilt to draw them
+        glyphsAdded = _fontAtlas->update(*_context);
+    }
+
+    // when idle, replay the ImDrawData from the last rebuild which remains valid until the next ImGui::NewFrame()
+    bool rebuild = !idlePolicy || idlePolicy->update() || glyphsAdded || !ImGui::GetDrawData();
+    if (rebuild)
+    {
+        // record all the ImGui commands to ImDrawData container
+        ImGui::NewFrame();
+
+        // traverse children
+        if (_childTimings)
+        {
+            _traverseTimed(rt);
+        }
+        else
+        {
+            for (auto& child : children)
+            {
+                if (_buildable(*child, rt)) child->accept(rt);
+            }
+        }
+
+        ImGui::EndFrame();
+        ImGui::Render();
+    }
+
+    return rebuild;
+}
+
+void RenderImGui::record(vsg::RecordTraversal& rt, bool unchanged) const
+{
+    const DeviceResources* resources = nullptr;
+    if (rt.getState()->_commandBuffer->getDevice() != _device.get())
+    {
+        resources = _getAdditionalDevice(*(rt.getState()->_commandBuffer));
+        if (!resources) return;
+    }
+
+    ContextScope scope(this);
+
+    _record(rt, resources, ImGui::GetDrawData(), unchanged);
+}
+
+void RenderImGui::_record(vsg::RecordTraversal& rt, const DeviceResources* resources, ImDrawData* draw_data, bool unchanged) const
+{
+    auto& commandBuffer = *(rt.getState()->_commandBuffer);
+
+    DrawDataRenderer* renderer = resources ? resources->renderer.get() : _renderer.get();
+    const FontAtlas* fontAtlas = resources ? resources->fontAtlas.get() : _fontAtlas.get();
+
+    if (renderer->getMaxBindlessTextures() > 0) _addBindlessTextures(*renderer, *fontAtlas, commandBuffer.deviceID);
 
     // if ImDrawData has been recorded then we need to clear the frame buffer and do the final record to Vulkan command buffer.
-    ImDrawData* draw_data = ImGui::GetDrawData();
     if (draw_data && draw_data->CmdListsCount > 0)
     {
         if (_clearAttachments) _clearAttachments->record(commandBuffer);
 
-        if (draw_data)
-            ImGui_ImplVulkan_RenderDrawData(draw_data, &(*commandBuffer));
+        renderer->record(*rt.getState(), draw_data, unchanged, rt.getFrameStamp() ? rt.getFrameStamp()->frameCount : 0);
+    }
+}
+
+void RenderImGui::accept(vsg::RecordTraversal& rt) const
+{
+    auto& commandBuffer = *(rt.getState()->_commandBuffer);
+
+    const DeviceResources* resources = nullptr;
+    if (_device.get() != commandBuffer.getDevice())
+    {
+        resources = _getAdditionalDevice(commandBuffer);
+        if (!resources) return;
+    }
+
+    if (_buildThread)
+    {
+        _recordSnapshot(rt, resources);
+        return;
+    }
+
+    auto frameCount = rt.getFrameStamp() ? rt.getFrameStamp()->frameCount : 0;
+    bool unchanged = false;
+    {
+        // the RenderImGui may be recorded for several windows/devices each frame, possibly from different threads, but the UI is only built once per frame
+        std::scoped_lock<std::mutex> lock(_recordMutex);
+        _buildFrame(rt, frameCount);
+
+        // the data uploaded for the most recent rebuild can be reused by the device until the next rebuild, even when the device
+        // wasn't recorded on the frames in between, while a device that missed the rebuild has to upload it
+        auto deviceID = commandBuffer.deviceID;
+        if (deviceID >= _uploadedFrames.size()) _uploadedFrames.resize(deviceID + 1);
+        unchanged = _rebuiltFrame && _uploadedFrames[deviceID] == _rebuiltFrame;
+        _uploadedFrames[deviceID] = _rebuiltFrame;
+    }
+
+    ContextScope scope(this);
+    _record(rt, resources, ImGui::GetDrawData(), unchanged);
+}
+
+void RenderImGui::_buildFrame(vsg::RecordTraversal& rt, uint64_t frameCount) const
+{
+    // called with _recordMutex held, the RenderImGui may be recorded for several windows/devices each frame but the UI is only built once per frame
+    if (_builtFrame && *_builtFrame == frameCount) return;
+    _builtFrame = frameCount;
+
+    if (!_buildThread)
+    {
+        if (build(rt)) _rebuiltFrame = frameCount;
+        return;
+    }
+
+    // compile and update the font atlas here, so _context is only used by this thread and the build thread only has ImGui work to do,
+    // and kick off the build of the next snapshot once the fonts are resident. If the build thread is still busy with the last request the requests are merged.
+    if (!_compile()) return;
+
+    // applying the uploaded glyphs modifies the fonts, so skip it while the build thread is using them and try again next frame
+    bool glyphsAdded = false;
+    if (_fontAtlas->dynamicGlyphs)
+    {
+        std::unique_lock<std::recursive_mutex> contextLock(_contextMutex, std::try_to_lock);
+        if (contextLock) glyphsAdded = _fontAtlas->update(*_context);
+    }
+
+    {
+        std::scoped_lock<std::mutex> buildLock(_buildThread->mutex);
+        _buildThread->requested = true;
+        _buildThread->glyphsAdded = _buildThread->glyphsAdded || glyphsAdded;
+        _buildThread->frameStamp = rt.getFrameStamp();
+    }
+    _buildThread->condition.notify_one();
+}
+
+RenderImGui::BuiltFrame RenderImGui::buildFrame(vsg::RecordTraversal& rt) const
+{
+    auto frameCount = rt.getFrameStamp() ? rt.getFrameStamp()->frameCount : 0;
+
+    std::scoped_lock<std::mutex> lock(_recordMutex);
+    _buildFrame(rt, frameCount);
+
+    // only hash the ImDrawData once per rebuild or snapshot
+    BuiltFrame builtFrame;
+    if (_buildThread)
+    {
+        vsg::ref_ptr<DrawDataSnapshot> snapshot;
+        {
+            std::scoped_lock<std::mutex> buildLock(_buildThread->mutex);
+            snapshot = _buildThread->snapshot;
+        }
+        if (!snapshot) return builtFrame;
+
+        if (snapshot != _fingerprintedSnapshot)
+        {
+            _fingerprint = DrawDataRenderer::fingerprint(&snapshot->drawData);
+            _fingerprintedSnapshot = snapshot;
+            builtFrame.rebuilt = true;
+        }
+    }
+    else
+    {
+        if (!_rebuiltFrame) return builtFrame;
+
+        if (_fingerprintedFrame != _rebuiltFrame)
+        {
+            ContextScope scope(this);
+            _fingerprint = DrawDataRenderer::fingerprint(ImGui::GetDrawData());
+            _fingerprintedFrame = _rebuiltFrame;
+        }
+        builtFrame.rebuilt = (*_rebuiltFrame == frameCount);
+    }
+
+    builtFrame.fingerprint = _fingerprint;
+    return builtFrame;
+}
+
+void RenderImGui::_recordSnapshot(vsg::RecordTraversal& rt, const DeviceResources* resources) const
+{
+    auto& commandBuffer = *(rt.getState()->_commandBuffer);
+    auto frameCount = rt.getFrameStamp() ? rt.getFrameStamp()->frameCount : 0;
+
+    vsg::ref_ptr<DrawDataSnapshot> snapshot;
+    bool unchanged = false;
+    {
+        std::scoped_lock<std::mutex> lock(_recordMutex);
+        _buildFrame(rt, frameCount);
+
+        {
+            std::scoped_lock<std::mutex> buildLock(_buildThread->mutex);
+            snapshot = _buildThread->snapshot;
+        }
+
+        // snapshots are immutable so one already recorded on this device can reuse the uploaded data
+        auto deviceID = commandBuffer.deviceID;
+        if (deviceID >= _recordedSnapshots.size()) _recordedSnapshots.resize(deviceID + 1);
+        unchanged = (_recordedSnapshots[deviceID] == snapshot);
+        _recordedSnapshots[deviceID] = snapshot;
+    }
+
+    // nothing is recorded until the build thread publishes its first snapshot
+    if (snapshot) _record(rt, resources, &snapshot->drawData, unchanged);
+}
+
+bool RenderImGui::_buildable(const vsg::Node& child, const vsg::RecordTraversal& rt) const
+{
+    // the build thread's RecordTraversal has no command buffer, so only the children that just call ImGui can be traversed by it
+    if (!_buildThread || &rt != _buildThread->traversal.get()) return true;
+    if (child.is_compatible(typeid(vsg::Command)) || child.is_compatible(typeid(ImGuiNode)) || child.is_compatible(typeid(PerformanceOverlay))) return true;
+
+    if (!_warnedBuildThreadChild)
+    {
+        vsg::warn("vsgImGui::RenderImGui build thread skipping child ", child.className(), ", only vsg::Command children calling ImGui can be built on the build thread.");
+        _warnedBuildThreadChild = true;
+    }
+    return false;
+}
+
+void RenderImGui::setupBuildThread()
+{
+    if (_buildThread) return;
+
+    _buildThread = std::make_unique<BuildThread>();
+    _buildThread->traversal = vsg::RecordTraversal::create();
+    _buildThread->thread = std::thread([this]() { _runBuildThread(); });
+}
+
+void RenderImGui::stopBuildThread()
+{
+    if (!_buildThread) return;
+
+    {
+        std::scoped_lock<std::mutex> lock(_buildThread->mutex);
+        _buildThread->stop = true;
+    }
+    _buildThread->condition.notify_one();
+    _buildThread->thread.join();
+
+    _buildThread.reset();
+    _recordedSnapshots.clear();
+}
+
+void RenderImGui::_runBuildThread() const
+{
+    auto& buildThread = *_buildThread;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(buildThread.mutex);
+            buildThread.condition.wait(lock, [&buildThread]() { return buildThread.requested || buildThread.stop; });
+            if (buildThread.stop) return;
+
+            buildThread.requested = false;
+            buildThread.traversal->setFrameStamp(buildThread.frameStamp);
+        }
+
+        // on idle frames the previous snapshot remains current
+        if (!build(*buildThread.traversal)) continue;
+
+        vsg::ref_ptr<DrawDataSnapshot> snapshot;
+        {
+            ContextScope scope(this);
+            snapshot = DrawDataSnapshot::create(ImGui::GetDrawData());
+        }
+
+        std::scoped_lock<std::mutex> lock(buildThread.mutex);
+        buildThread.snapshot = snapshot;
+    }
+}
+
+vsg::ref_ptr<vsg::SecondaryCommandGraph> RenderImGui::createSecondaryCommandGraph(vsg::ref_ptr<vsg::Window> window, uint32_t subpass)
+{
+    if (window->getOrCreateDevice() != _device) addWindow(window);
+
+    auto commandGraph = vsg::SecondaryCommandGraph::create(window, subpass);
+    commandGraph->addChild(vsg::ref_ptr<vsg::Node>(this));
+    return commandGraph;
+}
+
+void RenderImGui::setupBindlessTextures(uint32_t maxTextures)
+{
+    _renderer->setupBindlessTextures(maxTextures);
+
+    std::scoped_lock<std::mutex> lock(_devicesMutex);
+    for (auto& resources : _additionalDevices)
+    {
+        if (resources) resources->renderer->setupBindlessTextures(maxTextures);
+    }
+}
+
+void RenderImGui::_addBindlessTextures(DrawDataRenderer& renderer, const FontAtlas& fontAtlas, uint32_t deviceID) const
+{
+    // the renderer applies its textureMap before looking up the bindless index, so register this device's ImTextureIDs
+    if (fontAtlas.image && !fontAtlas.image->imageInfoList.empty())
+    {
+        auto id = fontAtlas.id();
+        if (!renderer.hasBindlessTexture(id)) renderer.addBindlessTexture(id, fontAtlas.image->imageInfoList.front());
+    }
+
+    std::scoped_lock<std::mutex> lock(_devicesMutex);
+    for (auto& texture : _textures)
+    {
+        auto id = texture->id(deviceID);
+        if (id == ImTextureID{} || renderer.hasBindlessTexture(id)) continue;
+
+        if (auto imageInfo = texture->getImageInfo()) renderer.addBindlessTexture(id, imageInfo);
+    }
+}
+
+void RenderImGui::addWindow(const vsg::ref_ptr<vsg::Window>& window)
+{
+    auto device = window->getOrCreateDevice();
+    if (device == _device) return;
+
+    // glyphs added at runtime are only copied into the primary device's atlas image, so would render blank on other devices
+    if (_fontAtlas->dynamicGlyphs)
+    {
+        vsg::warn("vsgImGui::RenderImGui::addWindow(..) not supported with FontAtlas::dynamicGlyphs, the UI won't be rendered on the window's device.");
+        return;
+    }
+
+    auto deviceID = device->deviceID;
+
+    std::scoped_lock<std::mutex> lock(_devicesMutex);
+    if (deviceID >= _additionalDevices.size()) _additionalDevices.resize(deviceID + 1);
+    if (_additionalDevices[deviceID]) return;
+
+    _additionalDevices[deviceID] = std::make_unique<DeviceResources>();
+    auto& resources = *_additionalDevices[deviceID];
+
+    uint32_t queueFamily = 0;
+    std::tie(queueFamily, std::ignore) = device->getPhysicalDevice()->getQueueFamily(window->traits()->queueFlags, window->getSurface());
+
+    resources.device = device;
+    resources.descriptorPools = DescriptorPools::create(device);
+
+    resources.context = vsg::Context::create(device);
+    resources.context->renderPass = window->getOrCreateRenderPass();
+    resources.context->graphicsQueue = device->getQueue(queueFamily);
+    resources.context->commandPool = vsg::CommandPool::create(device, queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+
+    uint32_t imageCount = std::max(static_cast<uint32_t>(window->numFrames()), 3u);
+    resources.renderer = DrawDataRenderer::create(*resources.context, imageCount);
+    resources.renderer->copySettings(*_renderer);
+    resources.renderer->setupBindlessTextures(_renderer->getMaxBindlessTextures());
+
+    // the ImFontAtlas's ImTextureID is the primary device's descriptor set, the renderer maps it to this device's set when recording
+    resources.fontAtlas = FontAtlas::create(_fontAtlas->atlas, resources.descriptorPools, resources.renderer->descriptorSetLayout);
+    resources.fontAtlas->assignTexID = false;
+}
+
+void RenderImGui::addTexture(vsg::ref_ptr<Texture> texture)
+{
+    std::scoped_lock<std::mutex> lock(_devicesMutex);
+    _textures.push_back(texture);
+    for (auto& resources : _additionalDevices)
+    {
+        if (resources) resources->ready = false;
+    }
+}
+
+const RenderImGui::DeviceResources* RenderImGui::_getAdditionalDevice(vsg::CommandBuffer& commandBuffer) const
+{
+    auto deviceID = commandBuffer.deviceID;
+
+    std::scoped_lock<std::mutex> lock(_devicesMutex);
+    if (deviceID >= _additionalDevices.size() || !_additionalDevices[deviceID] || _additionalDevices[deviceID]->device.get() != commandBuffer.getDevice())
+    {
+        if (!_warnedUnknownDevice)
+        {
+            vsg::warn("vsgImGui::RenderImGui recorded for a device without resources, use RenderImGui::addWindow(window) to render the UI on it.");
+            _warnedUnknownDevice = true;
+        }
+        return nullptr;
+    }
+
+    auto& resources = *_additionalDevices[deviceID];
+    if (resources.ready) return &resources;
+
+    // fallback for when the RenderImGui hasn't been compiled along with the rest of the scene graph, or textures have been added since.
+    // Rather than stalling the record traversal the UI isn't recorded on the device until the transfer has completed.
+    if (resources.uploadPending)
+    {
+        if (resources.context->fence && resources.context->fence->status() == VK_NOT_READY) return nullptr;
+
+        resources.context->waitForCompletion();
+        resources.uploadPending = false;
+    }
+
+    _compileAdditionalDevice(resources, nullptr);
+    return resources.ready ? &resources : nullptr;
+}
+
+void RenderImGui::_compileAdditionalDevice(DeviceResources& resources, vsg::Context* context) const
+{
+    // called with _devicesMutex held. When no context is provided the transfers are submitted on the device's own context, without waiting for them.
+    auto deviceID = resources.device->deviceID;
+    auto& transferContext = context ? *context : *resources.context;
+    bool transfersQueued = false;
+
+    if (!resources.renderer->compiled(deviceID))
+    {
+        // pick up the settings applied to the primary renderer since addWindow(..), the device's record thread doesn't use the renderer until it's ready
+        resources.renderer->copySettings(*_renderer);
+        resources.renderer->compile(*resources.context);
+    }
+    if (!resources.fontAtlas->compiled(deviceID))
+    {
+        resources.fontAtlas->compile(transferContext);
+        transfersQueued = true;
+    }
+
+    for (size_t i = resources.numCompiledTextures; i < _textures.size(); ++i)
+    {
+        _textures[i]->compile(transferContext);
+        transfersQueued = true;
+    }
+    resources.numCompiledTextures = _textures.size();
+
+    // ImGui is given the primary device's descriptor sets so map them to this device's equivalents
+    auto& textureMap = resources.renderer->textureMap;
+    textureMap[_fontAtlas->id()] = resources.fontAtlas->id();
+    for (auto& texture : _textures)
+    {
+        if (texture->descriptorSet) textureMap[texture->id(_device->deviceID)] = texture->id(deviceID);
+    }
+
+    if (transfersQueued && !context)
+    {
+        resources.context->record();
+        resources.uploadPending = true;
+        resources.ready = false;
+    }
+    else
+    {
+        // the CompileTraversal's transfers complete before the scene graph is recorded
+        resources.ready = true;
     }
 }
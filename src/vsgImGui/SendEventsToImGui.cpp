@@ -40,10 +40,25 @@ SendEventsToImGui::SendEventsToImGui() :
     _initKeymap();
 }
 
+SendEventsToImGui::SendEventsToImGui(vsg::ref_ptr<vsg::Window> in_window, vsg::ref_ptr<RenderImGui> in_renderImGui) :
+    window(in_window),
+    renderImGui(in_renderImGui),
+    _dragging(false)
+{
+    t0 = std::chrono::high_resolution_clock::now();
+
+    _initKeymap();
+}
+
 SendEventsToImGui::~SendEventsToImGui()
 {
 }
 
+bool SendEventsToImGui::_acceptEvent(const vsg::WindowEvent& event) const
+{
+    return !window || window == event.window;
+}
+
 uint32_t SendEventsToImGui::_convertButton(uint32_t button)
 {
     return button == 1 ? 0 : button == 3 ? 1
@@ -164,6 +179,11 @@ void SendEventsToImGui::_initKeymap()
 
 void SendEventsToImGui::apply(vsg::ButtonPressEvent& buttonPress)
 {
+    if (!_acceptEvent(buttonPress)) return;
+    RenderImGui::ContextScope scope(renderImGui.get());
+
+    _activity();
+
     ImGuiIO& io = ImGui::GetIO();
 
     if (io.WantCaptureMouse)
@@ -182,6 +202,11 @@ void SendEventsToImGui::apply(vsg::ButtonPressEvent& buttonPress)
 
 void SendEventsToImGui::apply(vsg::ButtonReleaseEvent& buttonRelease)
 {
+    if (!_acceptEvent(buttonRelease)) return;
+    RenderImGui::ContextScope scope(renderImGui.get());
+
+    _activity();
+
     ImGuiIO& io = ImGui::GetIO();
     if ((!_dragging) && io.WantCaptureMouse)
     {
@@ -197,6 +222,11 @@ void SendEventsToImGui::apply(vsg::ButtonReleaseEvent& buttonRelease)
 
 void SendEventsToImGui::apply(vsg::MoveEvent& moveEvent)
 {
+    if (!_acceptEvent(moveEvent)) return;
+    RenderImGui::ContextScope scope(renderImGui.get());
+
+    _activity();
+
     if (!_dragging)
     {
         ImGuiIO& io = ImGui::GetIO();
@@ -208,6 +238,11 @@ void SendEventsToImGui::apply(vsg::MoveEvent& moveEvent)
 
 void SendEventsToImGui::apply(vsg::ScrollWheelEvent& scrollWheel)
 {
+    if (!_acceptEvent(scrollWheel)) return;
+    RenderImGui::ContextScope scope(renderImGui.get());
+
+    _activity();
+
     if (!_dragging)
     {
         ImGuiIO& io = ImGui::GetIO();
@@ -239,6 +274,11 @@ void SendEventsToImGui::_updateModifier(ImGuiIO& io, vsg::KeyModifier& modifier,
 
 void SendEventsToImGui::apply(vsg::KeyPressEvent& keyPress)
 {
+    if (!_acceptEvent(keyPress)) return;
+    RenderImGui::ContextScope scope(renderImGui.get());
+
+    _activity();
+
     ImGuiIO& io = ImGui::GetIO();
 
     // We should always pass the event to ImGui
@@ -271,6 +311,11 @@ void SendEventsToImGui::apply(vsg::KeyPressEvent& keyPress)
 
 void SendEventsToImGui::apply(vsg::KeyReleaseEvent& keyRelease)
 {
+    if (!_acceptEvent(keyRelease)) return;
+    RenderImGui::ContextScope scope(renderImGui.get());
+
+    _activity();
+
     ImGuiIO& io = ImGui::GetIO();
 
     // We should always pass the event to ImGui
@@ -297,6 +342,11 @@ void SendEventsToImGui::apply(vsg::KeyReleaseEvent& keyRelease)
 
 void SendEventsToImGui::apply(vsg::ConfigureWindowEvent& configureWindow)
 {
+    if (!_acceptEvent(configureWindow)) return;
+    RenderImGui::ContextScope scope(renderImGui.get());
+
+    _activity();
+
     ImGuiIO& io = ImGui::GetIO();
     io.DisplaySize.x = static_cast<float>(configureWindow.width);
     io.DisplaySize.y = static_cast<float>(configureWindow.height);
@@ -304,6 +354,9 @@ void SendEventsToImGui::apply(vsg::ConfigureWindowEvent& configureWindow)
 
 void SendEventsToImGui::apply(vsg::FrameEvent& /*frame*/)
 {
+    // ImGui may be building the UI on a RenderImGui build thread so lock its contexts while updating the input state
+    RenderImGui::ContextScope scope(renderImGui.get());
+
     ImGuiIO& io = ImGui::GetIO();
 
     auto t1 = std::chrono::high_resolution_clock::now();
@@ -26,50 +26,112 @@ SOFTWARE.
 #include <vsgImGui/Texture.h>
 
 #include <vsg/state/DescriptorImage.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/Device.h>
+#include <vsg/vk/PhysicalDevice.h>
+
+#include <algorithm>
+#include <mutex>
 
 using namespace vsgImGui;
 
 namespace
 {
-    auto getDefaultSampler()
+    // samplers and the descriptor set layout are shared by the Textures that are alive, so the number of Vulkan objects doesn't grow with the number of
+    // textures. Only observer_ptr are held, so the objects, and the Devices they were compiled for, are released along with the last Texture using them.
+    struct SharedTextureObjects
+    {
+        std::mutex mutex;
+        vsg::observer_ptr<vsg::DescriptorSetLayout> descriptorSetLayout;
+        std::vector<vsg::observer_ptr<vsg::Sampler>> samplers;
+    };
+
+    SharedTextureObjects& getSharedObjects()
+    {
+        static SharedTextureObjects s_sharedObjects;
+        return s_sharedObjects;
+    }
+
+    vsg::ref_ptr<vsg::DescriptorSetLayout> getSharedDescriptorSetLayout()
+    {
+        auto& sharedObjects = getSharedObjects();
+        std::scoped_lock<std::mutex> lock(sharedObjects.mutex);
+
+        if (auto descriptorSetLayout = sharedObjects.descriptorSetLayout.ref_ptr()) return descriptorSetLayout;
+
+        vsg::DescriptorSetLayoutBindings descriptorBindings{
+            {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr} // { binding, descriptorType, descriptorCount, stageFlags, pImmutableSamplers }
+        };
+
+        auto descriptorSetLayout = vsg::DescriptorSetLayout::create(descriptorBindings);
+        sharedObjects.descriptorSetLayout = descriptorSetLayout;
+        return descriptorSetLayout;
+    }
+
+    // return a shared sampler with the same state as sampler, which is added to the shared samplers if there's no equivalent one alive
+    vsg::ref_ptr<vsg::Sampler> getSharedSampler(vsg::ref_ptr<vsg::Sampler> sampler)
     {
+        auto& sharedObjects = getSharedObjects();
+        std::scoped_lock<std::mutex> lock(sharedObjects.mutex);
+
+        auto& samplers = sharedObjects.samplers;
+        samplers.erase(std::remove_if(samplers.begin(), samplers.end(), [](const vsg::observer_ptr<vsg::Sampler>& observer) { return !observer.valid(); }), samplers.end());
+
+        for (auto& observer : samplers)
+        {
+            auto shared = observer.ref_ptr();
+            if (shared && shared->compare(*sampler) == 0) return shared;
+        }
+
+        samplers.emplace_back(sampler);
+        return sampler;
+    }
+
+    vsg::ref_ptr<vsg::Sampler> getDefaultSampler(bool generateMipmaps)
+    {
+        // vsg generates the mip levels on upload when the sampler's maxLod allows them, clamped to the size of the image
         auto sampler = vsg::Sampler::create();
-        sampler->maxLod = 9.0; // whatever for now
+        sampler->maxLod = generateMipmaps ? VK_LOD_CLAMP_NONE : 0.0f;
         sampler->addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
         sampler->addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
         sampler->addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
         return sampler;
     }
 
-    vsg::ref_ptr<vsg::DescriptorSet> makeImageDescriptorSet(vsg::ref_ptr<vsg::Data> data, vsg::ref_ptr<vsg::Sampler> sampler = {})
+    vsg::ref_ptr<vsg::DescriptorSet> makeImageDescriptorSet(vsg::ref_ptr<vsg::Data> data, vsg::ref_ptr<vsg::Sampler> sampler, bool generateMipmaps = true)
     {
         if (!data) return {};
-        // set up graphics pipeline
 
-        vsg::DescriptorSetLayoutBindings descriptorBindings{
-            {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr} // { binding, descriptorType, descriptorCount, stageFlags, pImmutableSamplers }
-        };
+        // share a copy of the caller's sampler, so the caller's object isn't handed to other Textures, nor changes made to it afterwards seen by them
+        sampler = sampler ? vsg::Sampler::create(*sampler) : getDefaultSampler(generateMipmaps);
 
-        auto descriptorSetLayout = vsg::DescriptorSetLayout::create(descriptorBindings);
-        // create texture image and associated DescriptorSets and binding
-        if (!sampler)
+        // vsg generates the mip levels missing from the data when the sampler's maxLod asks for more, which isn't possible for block compressed formats,
+        // so limit their samplers to the mip levels the data contains
+        const auto& properties = data->properties;
+        if (properties.blockWidth > 1 || properties.blockHeight > 1)
         {
-            sampler = getDefaultSampler();
+            float maxLod = static_cast<float>(std::max<uint32_t>(properties.maxNumMipmaps, 1) - 1);
+            sampler->maxLod = std::min(sampler->maxLod, maxLod);
+            sampler->minLod = std::min(sampler->minLod, sampler->maxLod);
         }
-        auto texture = vsg::DescriptorImage::create(sampler, data, 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
 
-        auto descriptorSet = vsg::DescriptorSet::create(descriptorSetLayout, vsg::Descriptors{texture});
+        // create texture image and associated DescriptorSets and binding, reusing the layout and an equivalent sampler of the other Textures
+        auto texture = vsg::DescriptorImage::create(getSharedSampler(sampler), data, 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+
+        auto descriptorSet = vsg::DescriptorSet::create(getSharedDescriptorSetLayout(), vsg::Descriptors{texture});
         return descriptorSet;
     }
 } // namespace
 
-Texture::Texture(vsg::ref_ptr<vsg::Data> data, vsg::ref_ptr<vsg::Sampler> sampler)
+Texture::Texture(vsg::ref_ptr<vsg::Data> data, vsg::ref_ptr<vsg::Sampler> sampler, bool generateMipmaps)
 {
     if (data)
     {
-        height = data->height();
-        width = data->width();
-        descriptorSet = makeImageDescriptorSet(data, sampler);
+        // the dimensions of block compressed data are in blocks
+        const auto& properties = data->properties;
+        height = data->height() * std::max<uint32_t>(properties.blockHeight, 1);
+        width = data->width() * std::max<uint32_t>(properties.blockWidth, 1);
+        descriptorSet = makeImageDescriptorSet(data, sampler, generateMipmaps);
     }
 }
 
@@ -80,9 +142,117 @@ Texture::~Texture()
 void Texture::compile(vsg::Context& context)
 {
     if (descriptorSet) descriptorSet->compile(context);
+
+    // the image is created from the current data, so only later modifications need copying to this device
+    std::scoped_lock<std::mutex> lock(_dirtyMutex);
+    if (context.deviceID >= _dirtyRegions.size()) _dirtyRegions.resize(context.deviceID + 1);
+    _dirtyRegions[context.deviceID].tracked = true;
 }
 
 ImTextureID Texture::id(uint32_t deviceID) const
 {
     return descriptorSet ? static_cast<ImTextureID>(descriptorSet->vk(deviceID)) : ImTextureID{};
 }
+
+bool Texture::isFormatSupported(vsg::Device& device, VkFormat format)
+{
+    auto formatProperties = device.getPhysicalDevice()->getFormatProperties(format);
+    return (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
+}
+
+vsg::ref_ptr<vsg::ImageInfo> Texture::getImageInfo() const
+{
+    if (!descriptorSet || descriptorSet->descriptors.empty()) return {};
+
+    auto descriptorImage = descriptorSet->descriptors.front().cast<vsg::DescriptorImage>();
+    return (descriptorImage && !descriptorImage->imageInfoList.empty()) ? descriptorImage->imageInfoList.front() : vsg::ref_ptr<vsg::ImageInfo>{};
+}
+
+vsg::ref_ptr<vsg::DescriptorSet> Texture::release()
+{
+    auto imageInfo = getImageInfo();
+    if (!imageInfo || !imageInfo->imageView || !imageInfo->imageView->image || !imageInfo->imageView->image->data) return {};
+
+    auto previous = descriptorSet;
+    descriptorSet = makeImageDescriptorSet(imageInfo->imageView->image->data, imageInfo->sampler);
+    return previous;
+}
+
+void Texture::dirty()
+{
+    dirty(VkRect2D{{0, 0}, {width, height}});
+}
+
+void Texture::dirty(const VkRect2D& region)
+{
+    std::scoped_lock<std::mutex> lock(_dirtyMutex);
+
+    // each device copies the regions when its UpdateTextures is recorded, so track them separately for every device the image has been compiled for
+    for (auto& deviceRegions : _dirtyRegions)
+    {
+        if (deviceRegions.tracked) _addDirtyRegion(deviceRegions.regions, region);
+    }
+}
+
+void Texture::dirty(uint32_t deviceID, const VkRect2D& region)
+{
+    std::scoped_lock<std::mutex> lock(_dirtyMutex);
+
+    if (deviceID < _dirtyRegions.size() && _dirtyRegions[deviceID].tracked) _addDirtyRegion(_dirtyRegions[deviceID].regions, region);
+}
+
+void Texture::_addDirtyRegion(std::vector<VkRect2D>& regions, const VkRect2D& region) const
+{
+    // a region covering the whole image replaces any others
+    if (region.offset.x <= 0 && region.offset.y <= 0 &&
+        static_cast<int64_t>(region.offset.x) + region.extent.width >= width && static_cast<int64_t>(region.offset.y) + region.extent.height >= height)
+    {
+        regions.assign(1, region);
+        return;
+    }
+
+    regions.push_back(region);
+
+    if (regions.size() > maxDirtyRegions)
+    {
+        int32_t x0 = regions.front().offset.x, y0 = regions.front().offset.y;
+        int64_t x1 = x0, y1 = y0;
+        for (auto& r : regions)
+        {
+            x0 = std::min(x0, r.offset.x);
+            y0 = std::min(y0, r.offset.y);
+            x1 = std::max(x1, static_cast<int64_t>(r.offset.x) + r.extent.width);
+            y1 = std::max(y1, static_cast<int64_t>(r.offset.y) + r.extent.height);
+        }
+        regions.assign(1, VkRect2D{{x0, y0}, {static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0)}});
+    }
+}
+
+std::vector<VkRect2D> Texture::takeDirtyRegions(uint32_t deviceID)
+{
+    std::vector<VkRect2D> regions;
+    {
+        std::scoped_lock<std::mutex> lock(_dirtyMutex);
+
+        // the descriptor set may have been compiled without Texture::compile(..), so start tracking the device from its first update
+        if (deviceID >= _dirtyRegions.size()) _dirtyRegions.resize(deviceID + 1);
+        _dirtyRegions[deviceID].tracked = true;
+        regions.swap(_dirtyRegions[deviceID].regions);
+    }
+
+    // clamp to the image, dropping regions that fall outside it
+    auto itr = regions.begin();
+    for (auto& region : regions)
+    {
+        int64_t x0 = std::max<int64_t>(region.offset.x, 0);
+        int64_t y0 = std::max<int64_t>(region.offset.y, 0);
+        int64_t x1 = std::min<int64_t>(static_cast<int64_t>(region.offset.x) + region.extent.width, width);
+        int64_t y1 = std::min<int64_t>(static_cast<int64_t>(region.offset.y) + region.extent.height, height);
+        if (x1 <= x0 || y1 <= y0) continue;
+
+        *itr++ = VkRect2D{{static_cast<int32_t>(x0), static_cast<int32_t>(y0)}, {static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0)}};
+    }
+    regions.erase(itr, regions.end());
+
+    return regions;
+}
@@ -0,0 +1,195 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/TextureResidency.h>
+
+#include <vsg/io/Logger.h>
+#include <vsg/state/ImageInfo.h>
+#include <vsg/state/ImageView.h>
+#include <vsg/vk/Fence.h>
+
+#include <algorithm>
+
+using namespace vsgImGui;
+
+namespace
+{
+    // bytes of GPU memory used by the image, block compressed data and data providing its own mip levels is uploaded as is,
+    // otherwise vsg generates the mip levels the sampler allows on the GPU
+    VkDeviceSize imageSize(const vsg::ImageInfo& imageInfo)
+    {
+        auto& data = imageInfo.imageView->image->data;
+        uint32_t mipLevels = vsg::computeNumMipMapLevels(data.get(), imageInfo.sampler.get());
+        if (data->properties.maxNumMipmaps > 1 || mipLevels <= 1) return data->dataSize();
+
+        VkDeviceSize size = 0;
+        uint32_t width = data->width(), height = data->height(), depth = data->depth();
+        for (uint32_t level = 0; level < mipLevels; ++level)
+        {
+            size += static_cast<VkDeviceSize>(width) * height * depth * data->properties.stride;
+            width = std::max(width / 2, 1u);
+            height = std::max(height / 2, 1u);
+            depth = std::max(depth / 2, 1u);
+        }
+        return size;
+    }
+} // namespace
+
+TextureResidency::TextureResidency(vsg::ref_ptr<vsg::Context> in_context, uint32_t in_numFramesInFlight) :
+    context(in_context),
+    _numFramesInFlight(std::max(in_numFramesInFlight, 1u))
+{
+}
+
+TextureResidency::~TextureResidency()
+{
+    // the images must outlive the copies to them
+    if (!_uploading.empty()) context->waitForCompletion();
+}
+
+ImTextureID TextureResidency::id(vsg::ref_ptr<Texture> texture)
+{
+    if (!texture || !texture->descriptorSet) return ImTextureID{};
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    // the placeholder is uploaded along with the first Textures, so nothing is drawn until that upload has completed
+    auto placeholderID = (placeholder && _placeholderUploaded) ? placeholder->id(context->deviceID) : ImTextureID{};
+
+    if (auto itr = _entries.find(texture.get()); itr != _entries.end())
+    {
+        ++_stats.numHits;
+
+        auto entry = itr->second;
+        entry->lastUsedFrame = _frameCount;
+        _lru.splice(_lru.begin(), _lru, entry);
+        return entry->uploaded ? texture->id(context->deviceID) : placeholderID;
+    }
+
+    // Textures without image data can't be released and compiled again, so aren't managed
+    auto imageInfo = texture->getImageInfo();
+    if (!imageInfo || !imageInfo->imageView || !imageInfo->imageView->image || !imageInfo->imageView->image->data) return texture->id(context->deviceID);
+
+    ++_stats.numMisses;
+
+    VkDeviceSize size = imageSize(*imageInfo);
+    _lru.push_front(Entry{texture, _frameCount, size, false});
+    _entries[texture.get()] = _lru.begin();
+    _queued.push_back(texture);
+
+    ++_stats.numResident;
+    _stats.residentBytes += size;
+
+    return placeholderID;
+}
+
+bool TextureResidency::_evict(LRU::iterator itr)
+{
+    auto& texture = itr->texture;
+
+    // the copy to the image may still be in flight
+    if (std::find(_uploading.begin(), _uploading.end(), texture) != _uploading.end()) return false;
+
+    if (!itr->uploaded)
+    {
+        _queued.erase(std::remove(_queued.begin(), _queued.end(), texture), _queued.end());
+    }
+    else if (auto released = texture->release())
+    {
+        _released.emplace_back(_frameCount, released);
+        ++_stats.numEvictions;
+    }
+    else
+    {
+        vsg::warn("vsgImGui::TextureResidency unable to release Texture, it remains resident.");
+        return false;
+    }
+
+    --_stats.numResident;
+    _stats.residentBytes -= itr->size;
+
+    _entries.erase(texture.get());
+    _lru.erase(itr);
+    return true;
+}
+
+void TextureResidency::update()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    // never wait on the upload, its Textures are drawn with the placeholder until it has completed
+    if (!_uploading.empty() && !(context->fence && context->fence->status() == VK_NOT_READY))
+    {
+        context->waitForCompletion();
+        for (auto& texture : _uploading)
+        {
+            if (auto itr = _entries.find(texture.get()); itr != _entries.end()) itr->second->uploaded = true;
+        }
+        _uploading.clear();
+        _placeholderUploaded = _placeholderCompiled;
+    }
+
+    // the least recently used Textures are at the back, stop at ones used in the frame just built
+    auto itr = _lru.end();
+    while (itr != _lru.begin())
+    {
+        auto entry = std::prev(itr);
+        if (entry->lastUsedFrame >= _frameCount) break;
+
+        bool unused = maxUnusedFrames > 0 && (_frameCount - entry->lastUsedFrame) >= maxUnusedFrames;
+        bool overBudget = budget > 0 && _stats.residentBytes > budget;
+        if (!unused && !overBudget) break;
+
+        // Textures that can't be evicted yet are skipped, itr remains valid when the entry before it is erased
+        if (!_evict(entry)) itr = entry;
+    }
+
+    while (!_released.empty() && (_frameCount - _released.front().first) >= _numFramesInFlight)
+    {
+        _released.pop_front();
+    }
+
+    // only one upload is in flight at a time, so the context's commands aren't added to while it's being submitted
+    if (_uploading.empty() && !_queued.empty())
+    {
+        if (placeholder && !_placeholderCompiled)
+        {
+            placeholder->compile(*context);
+            _placeholderCompiled = true;
+        }
+
+        for (auto& texture : _queued) texture->compile(*context);
+        context->record();
+
+        _uploading.swap(_queued);
+        ++_stats.numUploads;
+    }
+
+    ++_frameCount;
+}
+
+TextureResidency::Stats TextureResidency::getStats() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _stats;
+}
@@ -0,0 +1,196 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsgImGui/UpdateTextures.h>
+
+#include <vsg/io/Logger.h>
+#include <vsg/state/ImageView.h>
+#include <vsg/vk/CommandBuffer.h>
+
+#include <cstring>
+
+using namespace vsgImGui;
+
+UpdateTextures::UpdateTextures(uint32_t in_numFrames) :
+    _numFrames(std::max(in_numFrames, 1u))
+{
+}
+
+UpdateTextures::~UpdateTextures()
+{
+    for (auto& frames : _staging)
+    {
+        for (auto& staging : frames) _release(staging);
+    }
+}
+
+void UpdateTextures::_release(StagingBuffer& staging) const
+{
+    if (staging.data) staging.buffer->getDeviceMemory(staging.deviceID)->unmap();
+    staging = {};
+}
+
+void UpdateTextures::record(vsg::CommandBuffer& commandBuffer) const
+{
+    auto deviceID = commandBuffer.deviceID;
+
+    struct Upload
+    {
+        vsg::ref_ptr<Texture> texture;
+        vsg::ref_ptr<vsg::ImageInfo> imageInfo;
+        size_t stride;
+        std::vector<VkRect2D> regions;
+    };
+
+    std::vector<Upload> uploads;
+    VkDeviceSize totalSize = 0;
+    for (auto& texture : textures)
+    {
+        auto imageInfo = texture->getImageInfo();
+        if (!imageInfo || !imageInfo->imageView || !imageInfo->imageView->image) continue;
+
+        auto& data = imageInfo->imageView->image->data;
+        if (!data || imageInfo->imageView->image->vk(deviceID) == VK_NULL_HANDLE) continue;
+
+        // block compressed images can't be updated texel by texel
+        if (data->properties.blockWidth > 1 || data->properties.blockHeight > 1)
+        {
+            if (!texture->takeDirtyRegions(deviceID).empty()) vsg::warn("vsgImGui::UpdateTextures unable to update block compressed Texture, discarding its dirty regions.");
+            continue;
+        }
+
+        auto regions = texture->takeDirtyRegions(deviceID);
+        if (regions.empty()) continue;
+
+        // each region starts at an offset that is a multiple of both the texel size and 4, as vkCmdCopyBufferToImage requires
+        size_t stride = data->properties.stride;
+        VkDeviceSize alignment = stride * 4;
+        for (auto& region : regions)
+        {
+            totalSize = ((totalSize + alignment - 1) / alignment) * alignment;
+            totalSize += static_cast<VkDeviceSize>(region.extent.width) * region.extent.height * stride;
+        }
+        uploads.push_back(Upload{texture, imageInfo, stride, std::move(regions)});
+    }
+
+    if (uploads.empty()) return;
+
+    if (deviceID >= _staging.size())
+    {
+        _staging.resize(deviceID + 1);
+        _frameIndices.resize(deviceID + 1, 0);
+    }
+    auto& frames = _staging[deviceID];
+    if (frames.size() != _numFrames) frames.resize(_numFrames);
+
+    // the staging buffer was last used numFrames records of this device ago, so its previous copy has completed and it can be rewritten or replaced
+    auto& frameIndex = _frameIndices[deviceID];
+    auto& staging = frames[frameIndex];
+    frameIndex = (frameIndex + 1) % _numFrames;
+
+    if (totalSize > staging.size)
+    {
+        auto previousSize = staging.size;
+        _release(staging);
+
+        auto device = commandBuffer.getDevice();
+        staging.size = std::max(totalSize, previousSize * 2);
+        staging.deviceID = deviceID;
+        staging.buffer = vsg::createBufferAndMemory(vsg::ref_ptr<vsg::Device>(device), staging.size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        auto memory = staging.buffer->getDeviceMemory(deviceID);
+        if (memory->map(staging.buffer->getMemoryOffset(deviceID), staging.size, 0, &staging.data) != VK_SUCCESS)
+        {
+            vsg::warn("vsgImGui::UpdateTextures unable to map staging buffer.");
+            staging = {};
+
+            // return the regions to their Textures so they are copied by a later record(..)
+            for (auto& upload : uploads)
+            {
+                for (auto& region : upload.regions) upload.texture->dirty(deviceID, region);
+            }
+            return;
+        }
+    }
+
+    VkBuffer vk_buffer = staging.buffer->vk(deviceID);
+    auto destination = static_cast<uint8_t*>(staging.data);
+
+    VkDeviceSize offset = 0;
+    std::vector<VkBufferImageCopy> copies;
+    for (auto& upload : uploads)
+    {
+        auto& imageInfo = *upload.imageInfo;
+        auto& data = imageInfo.imageView->image->data;
+        auto source = static_cast<const uint8_t*>(data->dataPointer());
+        size_t rowSize = static_cast<size_t>(data->width()) * upload.stride;
+        VkDeviceSize alignment = upload.stride * 4;
+
+        copies.clear();
+        for (auto& region : upload.regions)
+        {
+            offset = ((offset + alignment - 1) / alignment) * alignment;
+
+            // pack the region's rows tightly into the staging buffer
+            size_t regionRowSize = static_cast<size_t>(region.extent.width) * upload.stride;
+            for (uint32_t row = 0; row < region.extent.height; ++row)
+            {
+                std::memcpy(destination + offset + row * regionRowSize, source + (region.offset.y + row) * rowSize + region.offset.x * upload.stride, regionRowSize);
+            }
+
+            VkBufferImageCopy copy{};
+            copy.bufferOffset = offset;
+            copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            copy.imageOffset = {region.offset.x, region.offset.y, 0};
+            copy.imageExtent = {region.extent.width, region.extent.height, 1};
+            copies.push_back(copy);
+
+            offset += regionRowSize * region.extent.height;
+            _stats.uploadedBytes += regionRowSize * region.extent.height;
+        }
+
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout = imageInfo.imageLayout;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = imageInfo.imageView->image->vk(deviceID);
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        vkCmdCopyBufferToImage(commandBuffer, vk_buffer, barrier.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(copies.size()), copies.data());
+
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = imageInfo.imageLayout;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        _stats.numUploadedRects += copies.size();
+    }
+
+    ++_stats.numUploads;
+}